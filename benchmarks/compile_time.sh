@@ -0,0 +1,54 @@
+#!/usr/bin/env bash
+# Measures the compile time of a translation unit that only uses eq/all,
+# depending on which predicates header it includes.
+#
+# usage: benchmarks/compile_time.sh <ferrugo-core include dir> [runs]
+set -euo pipefail
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <ferrugo-core include dir> [runs]" >&2
+    exit 2
+fi
+
+CXX=${CXX:-c++}
+CXXFLAGS=${CXXFLAGS:--std=c++17 -O2}
+CORE_INCLUDE=$1
+RUNS=${2:-5}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+write_tu() {
+    cat > "$WORK/$1.cpp" <<CPP
+#include <ferrugo/predicates/$1.hpp>
+
+namespace predicates = ferrugo::predicates;
+
+int main(int argc, char**)
+{
+    const auto pred = predicates::all(predicates::ge(1), predicates::lt(10), predicates::ne(5));
+    return pred(argc) ? 0 : 1;
+}
+CPP
+}
+
+best_time_ms() {
+    local best=""
+    for _ in $(seq "$RUNS"); do
+        local start end elapsed
+        start=$(date +%s%N)
+        $CXX $CXXFLAGS -I"$ROOT/include" -I"$CORE_INCLUDE" -c "$WORK/$1.cpp" -o "$WORK/$1.o"
+        end=$(date +%s%N)
+        elapsed=$(( (end - start) / 1000000 ))
+        if [ -z "$best" ] || [ "$elapsed" -lt "$best" ]; then
+            best=$elapsed
+        fi
+    done
+    echo "$best"
+}
+
+printf "%-16s %10s\n" "header" "best [ms]"
+for header in predicates core; do
+    write_tu "$header"
+    printf "%-16s %10s\n" "$header.hpp" "$(best_time_ms "$header")"
+done
@@ -0,0 +1,71 @@
+#!/usr/bin/env bash
+# Measures how the compile time of a single all(...) grows with the number of children,
+# both for mixed child types and for children that all share one type.
+#
+# usage: benchmarks/compile_time_scaling.sh <ferrugo-core include dir> [counts...]
+set -euo pipefail
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <ferrugo-core include dir> [counts...]" >&2
+    exit 2
+fi
+
+CXX=${CXX:-c++}
+CXXFLAGS=${CXXFLAGS:--std=c++17 -O1}
+CORE_INCLUDE=$1
+shift
+COUNTS=${*:-50 100 200 400 600 800 1000}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+child() {
+    local kind=$1 i=$2
+    if [ "$kind" = same ]; then
+        echo "predicates::ne($i)"
+        return
+    fi
+    case $((i % 4)) in
+        0) echo "predicates::ne($((-i - 1)))" ;;
+        1) echo "predicates::lt($((i + 1000000)))" ;;
+        2) echo "predicates::negate(predicates::eq($((-i - 1))))" ;;
+        3) echo "predicates::gt($((-i - 10)))" ;;
+    esac
+}
+
+write_tu() {
+    local kind=$1 count=$2 file=$3
+    {
+        echo "#include <ferrugo/predicates/core.hpp>"
+        echo
+        echo "namespace predicates = ferrugo::predicates;"
+        echo
+        echo "int main(int argc, char**)"
+        echo "{"
+        echo "    static const auto pred = predicates::all("
+        for i in $(seq 0 $((count - 1))); do
+            [ "$i" -eq $((count - 1)) ] && sep=");" || sep=","
+            echo "        $(child "$kind" "$i")$sep"
+        done
+        echo "    return pred(argc) ? 0 : 1;"
+        echo "}"
+    } > "$file"
+}
+
+time_ms() {
+    local start end
+    start=$(date +%s%N)
+    if ! $CXX $CXXFLAGS -I"$ROOT/include" -I"$CORE_INCLUDE" -c "$1" -o "$WORK/out.o" 2> "$WORK/err.txt"; then
+        echo "failed"
+        return
+    fi
+    end=$(date +%s%N)
+    echo $(( (end - start) / 1000000 ))
+}
+
+printf "%-10s %14s %14s\n" "children" "mixed [ms]" "same [ms]"
+for count in $COUNTS; do
+    write_tu mixed "$count" "$WORK/mixed.cpp"
+    write_tu same "$count" "$WORK/same.cpp"
+    printf "%-10s %14s %14s\n" "$count" "$(time_ms "$WORK/mixed.cpp")" "$(time_ms "$WORK/same.cpp")"
+done
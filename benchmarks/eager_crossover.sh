@@ -0,0 +1,92 @@
+#!/usr/bin/env bash
+# Compares short-circuit all/any with all_eager/any_eager over cheap comparisons,
+# depending on how often each child passes.
+#
+# usage: benchmarks/eager_crossover.sh <ferrugo-core include dir> [children]
+set -euo pipefail
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <ferrugo-core include dir> [children]" >&2
+    exit 2
+fi
+
+CXX=${CXX:-c++}
+CXXFLAGS=${CXXFLAGS:--std=c++17 -O2}
+CORE_INCLUDE=$1
+CHILDREN=${2:-4}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+children() {
+    local op=$1
+    for i in $(seq 0 $((CHILDREN - 1))); do
+        [ "$i" -eq $((CHILDREN - 1)) ] && sep="" || sep=", "
+        printf "predicates::element<%d>(predicates::%s(threshold))%s" "$i" "$op" "$sep"
+    done
+}
+
+cat > "$WORK/bench.cpp" <<CPP
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ferrugo/predicates/core.hpp>
+#include <random>
+#include <vector>
+
+namespace predicates = ferrugo::predicates;
+
+using record = std::array<int, ${CHILDREN}>;
+
+template <class Pred>
+double ns_per_item(const Pred& pred, const std::vector<record>& items)
+{
+    std::size_t hits = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 20; ++round)
+    {
+        for (const record& item : items)
+        {
+            hits += pred(item) ? 1 : 0;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    static volatile std::size_t sink = 0;
+    sink = sink + hits;
+    return elapsed / (20.0 * static_cast<double>(items.size()));
+}
+
+int main()
+{
+    std::mt19937 gen{ 42 };
+    std::uniform_int_distribution<int> dist{ 0, 999 };
+    std::vector<record> items(1 << 16);
+    for (record& item : items)
+    {
+        for (int& value : item)
+        {
+            value = dist(gen);
+        }
+    }
+    std::printf("%-10s %10s %10s %10s %10s\n", "pass [%]", "all", "all_eager", "any", "any_eager");
+    for (int percent = 0; percent <= 100; percent += 10)
+    {
+        const int threshold = percent * 10;
+        const auto all = predicates::all($(children lt));
+        const auto all_eager = predicates::all_eager($(children lt));
+        const auto any = predicates::any($(children lt));
+        const auto any_eager = predicates::any_eager($(children lt));
+        std::printf(
+            "%-10d %10.2f %10.2f %10.2f %10.2f\n",
+            percent,
+            ns_per_item(all, items),
+            ns_per_item(all_eager, items),
+            ns_per_item(any, items),
+            ns_per_item(any_eager, items));
+    }
+}
+CPP
+
+$CXX $CXXFLAGS -I"$ROOT/include" -I"$CORE_INCLUDE" "$WORK/bench.cpp" -o "$WORK/bench"
+echo "children: $CHILDREN, time in ns per item"
+"$WORK/bench"
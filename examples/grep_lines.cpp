@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstring>
+#include <ferrugo/predicates/line_scanner.hpp>
+#include <ferrugo/predicates/strings.hpp>
+#include <iostream>
+
+namespace predicates = ferrugo::predicates;
+
+int main(int argc, char* argv[])
+{
+    bool count_only = false;
+    bool ignore_case = false;
+    predicates::scan_options options;
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; ++arg)
+    {
+        if (std::strcmp(argv[arg], "-c") == 0)
+        {
+            count_only = true;
+        }
+        else if (std::strcmp(argv[arg], "-i") == 0)
+        {
+            ignore_case = true;
+        }
+        else if (std::strcmp(argv[arg], "-j") == 0 && arg + 1 < argc)
+        {
+            options.thread_count = std::stoul(argv[++arg]);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (argc - arg != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " [-c] [-i] [-j threads] PATTERN FILE" << '\n';
+        return 2;
+    }
+
+    try
+    {
+        const predicates::mapped_file file{ argv[arg + 1], predicates::access_pattern::sequential };
+        const auto pred = predicates::string_contains(
+            argv[arg],
+            ignore_case ? predicates::string_comparison::case_insensitive : predicates::string_comparison::case_sensitive);
+
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t matches = 0;
+        if (count_only)
+        {
+            matches = predicates::count_lines(file.contents(), pred, options);
+            std::cout << matches << '\n';
+        }
+        else
+        {
+            const auto offsets = predicates::find_lines(file.contents(), pred, options);
+            matches = offsets.size();
+            for (const std::size_t offset : offsets)
+            {
+                std::cout << predicates::line_at(file.contents(), offset) << '\n';
+            }
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << matches << " matching lines, " << file.contents().size() / (1024.0 * 1024.0) / elapsed << " MiB/s"
+                  << '\n';
+        return matches > 0 ? 0 : 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << '\n';
+        return 2;
+    }
+}
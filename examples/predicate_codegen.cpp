@@ -0,0 +1,31 @@
+#include <ferrugo/predicates/codegen.hpp>
+#include <iostream>
+
+namespace predicates = ferrugo::predicates;
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3 && argc != 4)
+    {
+        std::cerr << "usage: " << argv[0] << " PROGRAM RECORD_TYPE [FUNCTION_NAME]" << '\n';
+        return 2;
+    }
+
+    try
+    {
+        const predicates::mapped_program prog{ argv[1] };
+        predicates::codegen_options options;
+        options.record_type = argv[2];
+        if (argc == 4)
+        {
+            options.function_name = argv[3];
+        }
+        predicates::generate_cpp(std::cout, prog.view(), options);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << '\n';
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/core/source_location.hpp>
+#include <ferrugo/predicates/explain.hpp>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+struct assertion_error : std::runtime_error
+{
+    explicit assertion_error(std::string msg) : std::runtime_error(std::move(msg))
+    {
+    }
+};
+
+template <class T, class Pred>
+void assert_that(const T& item, const Pred& pred, const std::optional<::ferrugo::core::source_location>& loc = {})
+{
+    if (pred(item))
+    {
+        return;
+    }
+    std::stringstream ss;
+    ss << "assertion failed:" << '\n';
+    ss << "value: " << ::ferrugo::core::safe_format(item) << '\n';
+    ss << "does not match the predicate: " << ::ferrugo::core::safe_format(pred) << '\n';
+    if (const auto reason = explain(pred, item))
+    {
+        ss << "reason: " << *reason << '\n';
+    }
+    if (loc)
+    {
+        ss << "at " << *loc << "\n";
+    }
+    throw assertion_error{ ss.str() };
+}
+
+struct batch_options
+{
+    std::size_t max_failures = std::numeric_limits<std::size_t>::max();
+};
+
+template <class Range, class Pred>
+class batch_result
+{
+public:
+    using range_type = std::remove_cv_t<std::remove_reference_t<Range>>;
+
+    batch_result(Range&& range, Pred pred, const batch_options& options)
+        : m_range{ capture(std::forward<Range>(range)) }
+        , m_pred{ std::move(pred) }
+        , m_max_failures{ options.max_failures }
+    {
+        for (const auto& item : this->range())
+        {
+            if (!detail::invoke_pred(m_pred, item))
+            {
+                if (m_failures.size() < m_max_failures)
+                {
+                    m_failures.push_back(m_checked);
+                }
+                ++m_failure_count;
+            }
+            ++m_checked;
+        }
+    }
+
+    bool ok() const
+    {
+        return m_failure_count == 0;
+    }
+
+    explicit operator bool() const
+    {
+        return ok();
+    }
+
+    std::size_t checked() const
+    {
+        return m_checked;
+    }
+
+    std::size_t failure_count() const
+    {
+        return m_failure_count;
+    }
+
+    const std::vector<std::size_t>& failures() const
+    {
+        return m_failures;
+    }
+
+    void report(std::ostream& os, const std::optional<::ferrugo::core::source_location>& loc = {}) const
+    {
+        os << "assertion failed for " << m_failure_count << " of " << m_checked << " items:" << '\n';
+        auto it = std::begin(range());
+        std::size_t position = 0;
+        for (const std::size_t index : m_failures)
+        {
+            std::advance(it, static_cast<std::ptrdiff_t>(index - position));
+            position = index;
+            os << "item " << index << ": " << ::ferrugo::core::safe_format(*it) << '\n';
+        }
+        if (m_failure_count > m_failures.size())
+        {
+            os << "... and " << m_failure_count - m_failures.size() << " more" << '\n';
+        }
+        os << "do not match the predicate: " << ::ferrugo::core::safe_format(m_pred) << '\n';
+        if (loc)
+        {
+            os << "at " << *loc << "\n";
+        }
+    }
+
+    std::string report(const std::optional<::ferrugo::core::source_location>& loc = {}) const
+    {
+        std::stringstream ss;
+        report(ss, loc);
+        return ss.str();
+    }
+
+    const range_type& range() const
+    {
+        if constexpr (owns_range)
+        {
+            return m_range;
+        }
+        else
+        {
+            return *m_range;
+        }
+    }
+
+private:
+    static constexpr bool owns_range = !std::is_lvalue_reference_v<Range>;
+
+    static auto capture(Range&& range)
+    {
+        if constexpr (owns_range)
+        {
+            return range_type(std::move(range));
+        }
+        else
+        {
+            return static_cast<const range_type*>(&range);
+        }
+    }
+
+    std::conditional_t<owns_range, range_type, const range_type*> m_range;
+    Pred m_pred;
+    std::size_t m_max_failures;
+    std::size_t m_checked = 0;
+    std::size_t m_failure_count = 0;
+    std::vector<std::size_t> m_failures;
+};
+
+template <class Range, class Pred>
+auto check_batch(Range&& range, Pred pred, const batch_options& options = {}) -> batch_result<Range, Pred>
+{
+    return batch_result<Range, Pred>{ std::forward<Range>(range), std::move(pred), options };
+}
+
+template <class Range, class Pred>
+void assert_all(
+    const Range& range,
+    const Pred& pred,
+    const batch_options& options,
+    const std::optional<::ferrugo::core::source_location>& loc = {})
+{
+    const auto result = check_batch(range, pred, options);
+    if (!result)
+    {
+        throw assertion_error{ result.report(loc) };
+    }
+}
+
+template <class Range, class Pred>
+void assert_all(const Range& range, const Pred& pred, const std::optional<::ferrugo::core::source_location>& loc = {})
+{
+    assert_all(range, pred, batch_options{}, loc);
+}
+
+}  // namespace predicates
+}  // namespace ferrugo
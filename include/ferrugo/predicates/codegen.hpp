@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ferrugo/predicates/program.hpp>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+inline constexpr std::uint32_t plugin_abi_version = 1;
+
+struct codegen_options
+{
+    std::string record_type;
+    std::string function_name = "ferrugo_predicate";
+};
+
+namespace detail
+{
+
+inline void write_string_literal(std::ostream& os, std::string_view value, const char* suffix = "sv")
+{
+    os << '"';
+    for (const char ch : value)
+    {
+        const auto byte = static_cast<unsigned char>(ch);
+        if (ch == '"' || ch == '\\')
+        {
+            os << '\\' << ch;
+        }
+        else if (byte < 0x20 || byte >= 0x7F)
+        {
+            char buffer[5];
+            std::snprintf(buffer, sizeof(buffer), "\\%03o", byte);
+            os << buffer;
+        }
+        else
+        {
+            os << ch;
+        }
+    }
+    os << '"' << suffix;
+}
+
+inline void write_integer_literal(std::ostream& os, std::int64_t value)
+{
+    if (value == std::numeric_limits<std::int64_t>::min())
+    {
+        os << "std::numeric_limits<std::int64_t>::min()";
+    }
+    else
+    {
+        os << "std::int64_t(" << value << ")";
+    }
+}
+
+inline void write_real_literal(std::ostream& os, double value)
+{
+    if (std::isnan(value))
+    {
+        os << "std::numeric_limits<double>::quiet_NaN()";
+    }
+    else if (std::isinf(value))
+    {
+        os << (value < 0 ? "-" : "") << "std::numeric_limits<double>::infinity()";
+    }
+    else
+    {
+        std::ostringstream ss;
+        ss << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+        std::string text = ss.str();
+        if (text.find_first_of(".e") == std::string::npos)
+        {
+            text += ".0";
+        }
+        os << text;
+    }
+}
+
+inline void write_cpp_node(std::ostream& os, const program_view& prog, std::uint32_t index, int indent)
+{
+    const program_node n = prog.node_at(index);
+    const auto newline = [&](int level) { os << '\n' << std::string(4 * level, ' '); };
+    const auto write_children = [&]()
+    {
+        std::uint32_t child = index + 1;
+        while (child < index + n.size)
+        {
+            if (child != index + 1)
+            {
+                os << ",";
+            }
+            newline(indent + 1);
+            write_cpp_node(os, prog, child, indent + 1);
+            child += prog.node_at(child).size;
+        }
+        os << ")";
+    };
+    const auto write_string_test = [&](const char* name)
+    {
+        os << "predicates::" << name << "(";
+        write_string_literal(os, prog.string_at(n.a, n.b), "s");
+        os << ", predicates::string_comparison::" << (n.flags != 0 ? "case_insensitive" : "case_sensitive") << ")";
+    };
+    switch (n.op)
+    {
+        case opcode::all: os << "predicates::all("; return write_children();
+        case opcode::any: os << "predicates::any("; return write_children();
+        case opcode::negate: os << "predicates::negate("; return write_children();
+        case opcode::field: os << "predicates::element<" << n.a << ">("; return write_children();
+        case opcode::compare:
+            os << "predicates::" << static_cast<comparison>(n.flags) << "(";
+            switch (n.kind)
+            {
+                case program_value::kind::integer: write_integer_literal(os, prog.integer_at(n.a)); break;
+                case program_value::kind::real: write_real_literal(os, prog.real_at(n.a)); break;
+                default: write_string_literal(os, prog.string_at(n.a, n.b)); break;
+            }
+            os << ")";
+            return;
+        case opcode::string_is: return write_string_test("string_is");
+        case opcode::string_starts_with: return write_string_test("string_starts_with");
+        case opcode::string_ends_with: return write_string_test("string_ends_with");
+        case opcode::string_contains: return write_string_test("string_contains");
+        case opcode::is_in:
+            os << "predicates::any(";
+            for (std::uint32_t i = 0; i < n.b; ++i)
+            {
+                if (i != 0)
+                {
+                    os << ", ";
+                }
+                if (n.kind == program_value::kind::string)
+                {
+                    const string_entry entry = prog.string_entry_at(n.a, i);
+                    write_string_literal(os, prog.string_at(entry.offset, entry.size));
+                }
+                else
+                {
+                    write_integer_literal(os, prog.integer_at(n.a + i * sizeof(std::int64_t)));
+                }
+            }
+            os << ")";
+            return;
+    }
+}
+
+}  // namespace detail
+
+inline void generate_cpp(std::ostream& os, const program_view& prog, const codegen_options& options)
+{
+    if (options.record_type.empty())
+    {
+        throw program_error{ "codegen requires a record type" };
+    }
+    os << "// Generated by ferrugo::predicates::generate_cpp" << '\n';
+    os << "#include <cstddef>" << '\n';
+    os << "#include <cstdint>" << '\n';
+    os << "#include <ferrugo/predicates/predicates.hpp>" << '\n';
+    os << "#include <limits>" << '\n';
+    os << "#include <string>" << '\n';
+    os << "#include <string_view>" << '\n';
+    os << "#include <tuple>" << '\n';
+    os << '\n';
+    os << "namespace" << '\n';
+    os << "{" << '\n';
+    os << '\n';
+    os << "namespace predicates = ::ferrugo::predicates;" << '\n';
+    os << "using namespace std::string_literals;" << '\n';
+    os << "using namespace std::string_view_literals;" << '\n';
+    os << "using record_type = " << options.record_type << ";" << '\n';
+    os << '\n';
+    os << "const auto rule = ";
+    detail::write_cpp_node(os, prog, 0, 0);
+    os << ";" << '\n';
+    os << '\n';
+    os << "}  // namespace" << '\n';
+    os << '\n';
+    os << "extern \"C\" bool " << options.function_name << "(const void* item) noexcept" << '\n';
+    os << "{" << '\n';
+    os << "    return rule(*static_cast<const record_type*>(item));" << '\n';
+    os << "}" << '\n';
+    os << '\n';
+    os << "extern \"C\" std::uint32_t " << options.function_name << "_abi_version() noexcept" << '\n';
+    os << "{" << '\n';
+    os << "    return " << plugin_abi_version << ";" << '\n';
+    os << "}" << '\n';
+    os << '\n';
+    os << "extern \"C\" std::size_t " << options.function_name << "_record_size() noexcept" << '\n';
+    os << "{" << '\n';
+    os << "    return sizeof(record_type);" << '\n';
+    os << "}" << '\n';
+}
+
+inline auto generate_cpp(const program_view& prog, const codegen_options& options) -> std::string
+{
+    std::ostringstream ss;
+    generate_cpp(ss, prog, options);
+    return ss.str();
+}
+
+}  // namespace predicates
+}  // namespace ferrugo
@@ -0,0 +1,806 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <ferrugo/predicates/core.hpp>
+#include <iterator>
+#include <utility>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+namespace detail
+{
+
+template <class Range>
+using size_of_t = decltype(std::size(std::declval<const Range&>()));
+
+template <class Iter, class Compare>
+class sorted_range
+{
+public:
+    using iterator = Iter;
+    using compare_type = Compare;
+
+    sorted_range(Iter first, Iter last, Compare comp) : m_first{ first }, m_last{ last }, m_comp{ std::move(comp) }
+    {
+    }
+
+    Iter begin() const
+    {
+        return m_first;
+    }
+
+    Iter end() const
+    {
+        return m_last;
+    }
+
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(std::distance(m_first, m_last));
+    }
+
+    bool empty() const
+    {
+        return m_first == m_last;
+    }
+
+    const Compare& comp() const
+    {
+        return m_comp;
+    }
+
+private:
+    Iter m_first;
+    Iter m_last;
+    Compare m_comp;
+};
+
+template <class T>
+struct is_sorted_range : std::false_type
+{
+};
+
+template <class Iter, class Compare>
+struct is_sorted_range<sorted_range<Iter, Compare>> : std::true_type
+{
+};
+
+template <class Compare>
+struct sort_order : std::integral_constant<int, 0>
+{
+};
+
+template <class T>
+struct sort_order<std::less<T>> : std::integral_constant<int, 1>
+{
+};
+
+template <class T>
+struct sort_order<std::greater<T>> : std::integral_constant<int, -1>
+{
+};
+
+template <class Compare, class Value>
+struct compares_without_conversion : std::true_type
+{
+};
+
+template <class T, class Value>
+struct compares_without_conversion<std::less<T>, Value> : std::is_same<T, Value>
+{
+};
+
+template <class T, class Value>
+struct compares_without_conversion<std::greater<T>, Value> : std::is_same<T, Value>
+{
+};
+
+template <class Value>
+struct compares_without_conversion<std::less<>, Value> : std::true_type
+{
+};
+
+template <class Value>
+struct compares_without_conversion<std::greater<>, Value> : std::true_type
+{
+};
+
+template <class Op>
+inline constexpr bool is_interval_operator = std::is_same_v<Op, std::equal_to<>> || std::is_same_v<Op, std::less<>>
+                                             || std::is_same_v<Op, std::less_equal<>> || std::is_same_v<Op, std::greater<>>
+                                             || std::is_same_v<Op, std::greater_equal<>>;
+
+template <class Pred, class Compare>
+constexpr bool is_interval_predicate()
+{
+    if constexpr (core::is_detected<compare_operator_of, Pred>{})
+    {
+        using value_t = std::decay_t<decltype(std::declval<const Pred&>().m_value)>;
+        return is_interval_operator<compare_operator_of<Pred>> && compares_without_conversion<Compare, value_t>{};
+    }
+    else if constexpr (core::is_detected<compound_tag_of, Pred>{})
+    {
+        using storage_t = decltype(std::declval<const Pred&>().m_preds);
+        return std::is_same_v<compound_tag_of<Pred>, all_tag> && flat_size_v<storage_t> > 0
+               && index_fold<true, flat_size_v<storage_t>>(
+                   [](auto i) { return is_interval_predicate<flat_element_t<decltype(i)::value, storage_t>, Compare>(); });
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <class Pred, class Range>
+constexpr bool has_sorted_fast_path()
+{
+    if constexpr (is_sorted_range<Range>{})
+    {
+        using category_t = typename std::iterator_traits<typename Range::iterator>::iterator_category;
+        using compare_t = typename Range::compare_type;
+        return sort_order<compare_t>{} != 0 && is_interval_predicate<Pred, compare_t>()
+               && std::is_base_of_v<std::random_access_iterator_tag, category_t>;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <class Iter, class Compare, class Pred>
+auto satisfying_range(const sorted_range<Iter, Compare>& range, const Pred& pred) -> std::pair<Iter, Iter>
+{
+    Iter first = range.begin();
+    Iter last = range.end();
+    if constexpr (core::is_detected<compare_operator_of, Pred>{})
+    {
+        using op_t = compare_operator_of<Pred>;
+        constexpr bool ascending = sort_order<Compare>{} > 0;
+        constexpr bool is_lower = std::is_same_v<op_t, std::greater<>> || std::is_same_v<op_t, std::greater_equal<>>;
+        constexpr bool inclusive = !std::is_same_v<op_t, std::greater<>> && !std::is_same_v<op_t, std::less<>>;
+        const auto& value = pred.m_value;
+        if constexpr (std::is_same_v<op_t, std::equal_to<>>)
+        {
+            first = std::lower_bound(first, last, value, range.comp());
+            last = std::upper_bound(first, last, value, range.comp());
+        }
+        else if constexpr (is_lower == ascending)
+        {
+            first = inclusive ? std::lower_bound(first, last, value, range.comp())
+                              : std::upper_bound(first, last, value, range.comp());
+        }
+        else
+        {
+            last = inclusive ? std::upper_bound(first, last, value, range.comp())
+                             : std::lower_bound(first, last, value, range.comp());
+        }
+    }
+    else
+    {
+        flat_for_each(
+            pred.m_preds,
+            [&](const auto& child)
+            {
+                const std::pair<Iter, Iter> r = satisfying_range(range, child);
+                first = std::max(first, r.first);
+                last = std::min(last, r.second);
+            });
+        last = std::max(first, last);
+    }
+    return { first, last };
+}
+
+struct assume_sorted_fn
+{
+    template <class Range, class Compare = std::less<>>
+    auto operator()(const Range& range, Compare comp = {}) const -> sorted_range<decltype(std::begin(range)), Compare>
+    {
+        return sorted_range<decltype(std::begin(range)), Compare>{ std::begin(range), std::end(range), std::move(comp) };
+    }
+};
+
+struct size_is_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        static constexpr std::size_t cost = 1 + predicate_cost<Pred>();
+
+        Pred m_pred;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            if constexpr (core::is_detected<size_of_t, std::decay_t<U>>{})
+            {
+                return invoke_pred(m_pred, static_cast<std::ptrdiff_t>(std::size(item)));
+            }
+            else
+            {
+                return invoke_pred(m_pred, std::distance(std::begin(item), std::end(item)));
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(size_is " << item.m_pred << ")";
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred&& pred) const -> impl<std::decay_t<Pred>>
+    {
+        return impl<std::decay_t<Pred>>{ std::forward<Pred>(pred) };
+    }
+};
+
+struct is_empty_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return std::begin(item) == std::end(item);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_empty)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+
+struct each_item_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        static constexpr std::size_t cost = scan_cost * predicate_cost<Pred>();
+
+        Pred m_pred;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            if constexpr (has_sorted_fast_path<Pred, std::decay_t<U>>())
+            {
+                return item.empty() || (invoke_pred(m_pred, *item.begin()) && invoke_pred(m_pred, *std::prev(item.end())));
+            }
+            else if constexpr (has_batch_kernel<Pred, std::remove_reference_t<U>>())
+            {
+                return m_pred.batch_all(std::data(item), std::size(item));
+            }
+            else
+            {
+                return std::all_of(
+                    std::begin(item),
+                    std::end(item),
+                    [&](auto&& v) { return invoke_pred(m_pred, std::forward<decltype(v)>(v)); });
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(each_item " << item.m_pred << ")";
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred&& pred) const -> impl<std::decay_t<Pred>>
+    {
+        return impl<std::decay_t<Pred>>{ std::forward<Pred>(pred) };
+    }
+};
+
+struct contains_item_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        static constexpr std::size_t cost = scan_cost * predicate_cost<Pred>();
+
+        Pred m_pred;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            if constexpr (has_sorted_fast_path<Pred, std::decay_t<U>>())
+            {
+                const auto r = satisfying_range(item, m_pred);
+                return r.first != r.second;
+            }
+            else if constexpr (has_batch_kernel<Pred, std::remove_reference_t<U>>())
+            {
+                return m_pred.batch_any(std::data(item), std::size(item));
+            }
+            else
+            {
+                return std::any_of(
+                    std::begin(item),
+                    std::end(item),
+                    [&](auto&& v) { return invoke_pred(m_pred, std::forward<decltype(v)>(v)); });
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(contains_item " << item.m_pred << ")";
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred&& pred) const -> impl<std::decay_t<Pred>>
+    {
+        return impl<std::decay_t<Pred>>{ std::forward<Pred>(pred) };
+    }
+};
+
+struct items_are
+{
+};
+
+template <class L, class R>
+constexpr bool is_bytewise_comparable()
+{
+    return std::is_same_v<L, R> && (std::is_integral_v<L> || std::is_enum_v<L>)
+           && std::has_unique_object_representations_v<L>;
+}
+
+template <class Range, class Item>
+constexpr bool has_bytewise_path()
+{
+    if constexpr (core::is_detected<contiguous_value_t, Range>{} && core::is_detected<contiguous_value_t, Item>{})
+    {
+        return is_bytewise_comparable<contiguous_value_t<Range>, contiguous_value_t<Item>>();
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <class Item, class... Values>
+constexpr bool has_bytewise_items_path()
+{
+    if constexpr (sizeof...(Values) > 0 && core::is_detected<contiguous_value_t, Item>{})
+    {
+        return all_true<is_bytewise_comparable<Values, contiguous_value_t<Item>>()...>;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <class T>
+bool bytewise_equal(const T* lhs, const T* rhs, std::size_t count)
+{
+    return count == 0 || std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+}
+
+template <class T, class... Values>
+auto to_array(const std::tuple<Values...>& values) -> std::array<T, sizeof...(Values)>
+{
+    return std::apply([](const auto&... v) { return std::array<T, sizeof...(Values)>{ v... }; }, values);
+}
+
+struct items_are_fn
+{
+    template <std::size_t N = 0, class... Preds, class Iter>
+    static bool call(const std::tuple<Preds...>& preds, Iter begin, Iter end)
+    {
+        if constexpr (N == sizeof...(Preds))
+        {
+            return begin == end;
+        }
+        else
+        {
+            return begin != end && invoke_pred(std::get<N>(preds), *begin) && call<N + 1>(preds, std::next(begin), end);
+        }
+    }
+    template <class... Preds>
+    struct impl
+    {
+        static constexpr std::size_t cost = (std::size_t{ 0 } + ... + predicate_cost<Preds>());
+
+        std::tuple<Preds...> m_preds;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            using item_t = std::remove_reference_t<decltype(unwrap(item))>;
+            if constexpr (has_bytewise_items_path<item_t, Preds...>())
+            {
+                const auto values = to_array<contiguous_value_t<item_t>>(m_preds);
+                return std::size(unwrap(item)) == values.size()
+                       && bytewise_equal(values.data(), std::data(unwrap(item)), values.size());
+            }
+            else
+            {
+                return call(m_preds, std::begin(item), std::end(item));
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            os << "("
+               << "items_are";
+            std::apply(
+                [&](const auto&... preds) { ((os << " " << ::ferrugo::core::safe_format(preds)), ...); }, item.m_preds);
+            os << ")";
+            return os;
+        }
+    };
+
+    template <class... Preds>
+    auto operator()(Preds&&... preds) const -> impl<std::decay_t<Preds>...>
+    {
+        return impl<std::decay_t<Preds>...>{ { std::forward<Preds>(preds)... } };
+    }
+};
+
+struct items_are_array_fn
+{
+    template <class PIter, class Iter>
+    static bool call(PIter p_b, PIter p_e, Iter begin, Iter end)
+    {
+        return std::equal(p_b, p_e, begin, end, [](auto&& p, auto&& it) { return invoke_pred(p, it); });
+    }
+    template <class Range>
+    struct impl
+    {
+        static constexpr std::size_t cost = scan_cost;
+
+        Range m_range;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            using range_t = std::remove_reference_t<decltype(unwrap(m_range))>;
+            using item_t = std::remove_reference_t<U>;
+            if constexpr (has_bytewise_path<range_t, item_t>())
+            {
+                const std::size_t size = std::size(unwrap(m_range));
+                return size == std::size(item) && bytewise_equal(std::data(unwrap(m_range)), std::data(item), size);
+            }
+            else if constexpr (
+                core::is_detected<contiguous_value_t, range_t>{} && core::is_detected<contiguous_value_t, item_t>{})
+            {
+                if constexpr (core::is_detected<batch_items_are, contiguous_value_t<range_t>, contiguous_value_t<item_t>>{})
+                {
+                    const std::size_t size = std::size(unwrap(m_range));
+                    return size == std::size(item)
+                           && contiguous_value_t<range_t>::batch_items_are(std::data(unwrap(m_range)), std::data(item), size);
+                }
+            }
+            return call(std::begin(unwrap(m_range)), std::end(unwrap(m_range)), std::begin(item), std::end(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "("
+                      << "items_are_array " << ::ferrugo::core::safe_format(item.m_range) << ")";
+        }
+    };
+
+    template <class Range>
+    auto operator()(Range range) const -> impl<Range>
+    {
+        return impl<Range>{ std::move(range) };
+    }
+};
+
+struct starts_with_items_fn
+{
+    template <class... Preds>
+    struct impl
+    {
+        static constexpr std::size_t cost = (std::size_t{ 0 } + ... + predicate_cost<Preds>());
+
+        std::tuple<Preds...> m_preds;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            using item_t = std::remove_reference_t<decltype(unwrap(item))>;
+            if constexpr (has_bytewise_items_path<item_t, Preds...>())
+            {
+                const auto values = to_array<contiguous_value_t<item_t>>(m_preds);
+                const std::size_t size = std::size(unwrap(item));
+                return size >= values.size() && bytewise_equal(values.data(), std::data(unwrap(item)) + 0, values.size());
+            }
+            else
+            {
+                const auto b = std::begin(unwrap(item));
+                const auto e = std::end(unwrap(item));
+                const auto preds_count = sizeof...(Preds);
+                const auto size = std::distance(b, e);
+                return size >= preds_count && items_are_fn ::call(m_preds, b, std::next(b, preds_count));
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            os << "("
+               << "starts_with_items";
+            std::apply(
+                [&](const auto&... preds) { ((os << " " << ::ferrugo::core::safe_format(preds)), ...); }, item.m_preds);
+            os << ")";
+            return os;
+        }
+    };
+
+    template <class... Preds>
+    auto operator()(Preds&&... preds) const -> impl<std::decay_t<Preds>...>
+    {
+        return impl<std::decay_t<Preds>...>{ { std::forward<Preds>(preds)... } };
+    }
+};
+
+struct starts_with_array_fn
+{
+    template <class Range>
+    struct impl
+    {
+        static constexpr std::size_t cost = scan_cost;
+
+        Range m_range;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            using range_t = std::remove_reference_t<decltype(unwrap(m_range))>;
+            using item_t = std::remove_reference_t<decltype(unwrap(item))>;
+            if constexpr (has_bytewise_path<range_t, item_t>())
+            {
+                const std::size_t count = std::size(unwrap(m_range));
+                const std::size_t size = std::size(unwrap(item));
+                return size >= count && bytewise_equal(std::data(unwrap(m_range)), std::data(unwrap(item)) + 0, count);
+            }
+            else
+            {
+                const auto p_b = std::begin(unwrap(m_range));
+                const auto p_e = std::end(unwrap(m_range));
+                const auto b = std::begin(unwrap(item));
+                const auto e = std::end(unwrap(item));
+                const auto preds_count = std::distance(p_b, p_e);
+                const auto size = std::distance(b, e);
+                return size >= preds_count && items_are_array_fn::call(p_b, p_e, b, std::next(b, preds_count));
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "("
+                      << "starts_with_array " << ::ferrugo::core::safe_format(item.m_range) << ")";
+        }
+    };
+
+    template <class Range>
+    auto operator()(Range range) const -> impl<Range>
+    {
+        return impl<Range>{ std::move(range) };
+    }
+};
+
+struct ends_with_items_fn
+{
+    template <class... Preds>
+    struct impl
+    {
+        static constexpr std::size_t cost = (std::size_t{ 0 } + ... + predicate_cost<Preds>());
+
+        std::tuple<Preds...> m_preds;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            using item_t = std::remove_reference_t<decltype(unwrap(item))>;
+            if constexpr (has_bytewise_items_path<item_t, Preds...>())
+            {
+                const auto values = to_array<contiguous_value_t<item_t>>(m_preds);
+                const std::size_t size = std::size(unwrap(item));
+                return size >= values.size()
+                       && bytewise_equal(values.data(), std::data(unwrap(item)) + size - values.size(), values.size());
+            }
+            else
+            {
+                const auto b = std::begin(unwrap(item));
+                const auto e = std::end(unwrap(item));
+                const auto preds_count = sizeof...(Preds);
+                const auto size = std::distance(b, e);
+                return size >= preds_count && items_are_fn::call(m_preds, std::next(b, size - preds_count), e);
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            os << "("
+               << "ends_with_items";
+            std::apply(
+                [&](const auto&... preds) { ((os << " " << ::ferrugo::core::safe_format(preds)), ...); }, item.m_preds);
+            os << ")";
+            return os;
+        }
+    };
+
+    template <class... Preds>
+    auto operator()(Preds&&... preds) const -> impl<std::decay_t<Preds>...>
+    {
+        return impl<std::decay_t<Preds>...>{ { std::forward<Preds>(preds)... } };
+    }
+};
+
+struct ends_with_array_fn
+{
+    template <class Range>
+    struct impl
+    {
+        static constexpr std::size_t cost = scan_cost;
+
+        Range m_range;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            using range_t = std::remove_reference_t<decltype(unwrap(m_range))>;
+            using item_t = std::remove_reference_t<decltype(unwrap(item))>;
+            if constexpr (has_bytewise_path<range_t, item_t>())
+            {
+                const std::size_t count = std::size(unwrap(m_range));
+                const std::size_t size = std::size(unwrap(item));
+                return size >= count
+                       && bytewise_equal(std::data(unwrap(m_range)), std::data(unwrap(item)) + size - count, count);
+            }
+            else
+            {
+                const auto p_b = std::begin(unwrap(m_range));
+                const auto p_e = std::end(unwrap(m_range));
+                const auto b = std::begin(unwrap(item));
+                const auto e = std::end(unwrap(item));
+                const auto preds_count = std::distance(p_b, p_e);
+                const auto size = std::distance(b, e);
+                return size >= preds_count && items_are_array_fn::call(p_b, p_e, std::next(b, size - preds_count), e);
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "("
+                      << "ends_with_array " << ::ferrugo::core::safe_format(item.m_range) << ")";
+        }
+    };
+
+    template <class Range>
+    auto operator()(Range range) const -> impl<Range>
+    {
+        return impl<Range>{ std::move(range) };
+    }
+};
+
+struct contains_items_fn
+{
+    template <class... Preds>
+    struct impl
+    {
+        static constexpr std::size_t cost = scan_cost * (std::size_t{ 0 } + ... + predicate_cost<Preds>());
+
+        std::tuple<Preds...> m_preds;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            const auto b = std::begin(unwrap(item));
+            const auto e = std::end(unwrap(item));
+            const auto preds_count = sizeof...(Preds);
+            const auto size = std::distance(b, e);
+            if (size < preds_count)
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < size - preds_count + 1; ++i)
+            {
+                if (items_are_fn::call(m_preds, std::next(b, i), std::next(b, i + preds_count)))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            os << "("
+               << "contains_items";
+            std::apply(
+                [&](const auto&... preds) { ((os << " " << ::ferrugo::core::safe_format(preds)), ...); }, item.m_preds);
+            os << ")";
+            return os;
+        }
+    };
+
+    template <class... Preds>
+    auto operator()(Preds&&... preds) const -> impl<std::decay_t<Preds>...>
+    {
+        return impl<std::decay_t<Preds>...>{ { std::forward<Preds>(preds)... } };
+    }
+};
+
+struct contains_array_fn
+{
+    template <class Range>
+    struct impl
+    {
+        static constexpr std::size_t cost = scan_cost;
+
+        Range m_range;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            const auto p_b = std::begin(unwrap(m_range));
+            const auto p_e = std::end(unwrap(m_range));
+            const auto b = std::begin(unwrap(item));
+            const auto e = std::end(unwrap(item));
+            const auto preds_count = std::distance(p_b, p_e);
+            const auto size = std::distance(b, e);
+            if (size < preds_count)
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < size - preds_count + 1; ++i)
+            {
+                if (items_are_array_fn::call(p_b, p_e, std::next(b, i), std::next(b, i + preds_count)))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "("
+                      << "contains_array " << ::ferrugo::core::safe_format(item.m_range) << ")";
+        }
+    };
+
+    template <class Range>
+    auto operator()(Range range) const -> impl<Range>
+    {
+        return impl<Range>{ std::move(range) };
+    }
+};
+
+}  // namespace detail
+
+inline constexpr auto each_item = detail::each_item_fn{};
+inline constexpr auto contains_item = detail::contains_item_fn{};
+inline constexpr auto size_is = detail::size_is_fn{};
+inline constexpr auto is_empty = detail::is_empty_fn{};
+inline constexpr auto assume_sorted = detail::assume_sorted_fn{};
+
+inline constexpr auto items_are = detail::items_are_fn{};
+inline constexpr auto items_are_array = detail::items_are_array_fn{};
+inline constexpr auto starts_with_items = detail::starts_with_items_fn{};
+inline constexpr auto starts_with_array = detail::starts_with_array_fn{};
+inline constexpr auto ends_with_items = detail::ends_with_items_fn{};
+inline constexpr auto ends_with_array = detail::ends_with_array_fn{};
+inline constexpr auto contains_items = detail::contains_items_fn{};
+inline constexpr auto contains_array = detail::contains_array_fn{};
+
+}  // namespace predicates
+}  // namespace ferrugo
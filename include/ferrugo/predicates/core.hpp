@@ -0,0 +1,963 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/core/str_t.hpp>
+#include <ferrugo/core/type_traits.hpp>
+#include <ferrugo/core/types.hpp>
+#include <ferrugo/predicates/scratch.hpp>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+namespace detail
+{
+
+struct unwrap_fn
+{
+    template <class T>
+    auto operator()(T& item) const -> T&
+    {
+        return item;
+    }
+
+    template <class T>
+    auto operator()(std::reference_wrapper<T> item) const -> T&
+    {
+        return item;
+    }
+};
+
+inline constexpr auto unwrap = unwrap_fn{};
+
+template <class L, class R>
+using is_equality_comparable = decltype(std::declval<L>() == std::declval<R>());
+
+template <class Pred, class T>
+constexpr bool invoke_pred(Pred&& pred, T&& item)
+{
+    if constexpr (std::is_invocable_v<Pred, T>)
+    {
+        return std::invoke(std::forward<Pred>(pred), std::forward<T>(item));
+    }
+    else if constexpr (core::is_detected<is_equality_comparable, T, Pred>{})
+    {
+        return pred == item;
+    }
+    else
+    {
+        static_assert(ferrugo::core::always_false<T>::value, "type must be either equality comparable or invocable");
+    }
+}
+
+template <class Range>
+using contiguous_value_t = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<Range&>()))>>;
+
+template <class Pred, class V>
+using batch_all_of = decltype(std::declval<const Pred&>().batch_all(std::declval<const V*>(), std::size_t{}));
+
+template <class Pred, class V>
+using batch_items_are = decltype(Pred::batch_items_are(std::declval<const Pred*>(), std::declval<const V*>(), std::size_t{}));
+
+template <bool All, class V, class Test>
+bool batch_scan(const V* data, std::size_t size, Test test)
+{
+    static constexpr std::size_t lanes = 32;
+    std::size_t i = 0;
+    for (; i + lanes <= size; i += lanes)
+    {
+        int found = 0;
+        for (std::size_t j = 0; j < lanes; ++j)
+        {
+            found += test(data[i + j]) != All;
+        }
+        if (found != 0)
+        {
+            return !All;
+        }
+    }
+    for (; i < size; ++i)
+    {
+        if (test(data[i]) != All)
+        {
+            return !All;
+        }
+    }
+    return All;
+}
+
+template <class Pred, class Range>
+constexpr bool has_batch_kernel()
+{
+    if constexpr (core::is_detected<contiguous_value_t, Range>{})
+    {
+        return core::is_detected<batch_all_of, Pred, contiguous_value_t<Range>>{};
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <class Pred>
+using projection_of = typename Pred::projection_type;
+
+template <class Pred>
+using compare_operator_of = typename Pred::operator_type;
+
+template <class Pred>
+using compound_tag_of = typename Pred::tag_type;
+
+template <class Pred>
+using field_index_of = decltype(Pred::field_index);
+
+template <class Pred>
+using alternative_of = typename Pred::alternative_type;
+
+template <class Pred>
+using declared_cost_of = decltype(Pred::cost);
+
+inline constexpr std::size_t unknown_cost = 8;
+inline constexpr std::size_t scan_cost = 16;
+
+template <class Pred>
+constexpr std::size_t predicate_cost()
+{
+    if constexpr (core::is_detected<declared_cost_of, Pred>{})
+    {
+        return Pred::cost;
+    }
+    else if constexpr (std::is_arithmetic_v<Pred> || std::is_enum_v<Pred>)
+    {
+        return 1;
+    }
+    else
+    {
+        return unknown_cost;
+    }
+}
+
+template <class T>
+using valueless_by_exception_t = decltype(std::declval<const T&>().valueless_by_exception());
+
+template <class Cases, class Variant>
+bool match_variant(const Cases& cases, const Variant& item);
+
+template <class T>
+struct type_key
+{
+    static constexpr char value = 0;
+};
+
+template <class Pred>
+constexpr const void* projection_key()
+{
+    if constexpr (core::is_detected<projection_of, Pred>{})
+    {
+        using func_t = projection_of<Pred>;
+        if constexpr (std::is_empty_v<func_t> || core::is_detected<is_equality_comparable, const func_t&, const func_t&>{})
+        {
+            return &type_key<func_t>::value;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+template <class Func>
+constexpr bool same_projection(const Func& lhs, const Func& rhs)
+{
+    if constexpr (std::is_empty_v<Func>)
+    {
+        return true;
+    }
+    else
+    {
+        return lhs == rhs;
+    }
+}
+
+template <bool... Values>
+struct bool_pack
+{
+};
+
+template <bool... Values>
+inline constexpr bool all_true = std::is_same_v<bool_pack<true, Values...>, bool_pack<Values..., true>>;
+
+template <std::size_t I, class T>
+struct flat_leaf
+{
+    T m_value;
+};
+
+template <class Indices, class... Ts>
+struct flat_tuple_base;
+
+template <std::size_t... I, class... Ts>
+struct flat_tuple_base<std::index_sequence<I...>, Ts...> : flat_leaf<I, Ts>...
+{
+    constexpr explicit flat_tuple_base(Ts... values) : flat_leaf<I, Ts>{ std::move(values) }...
+    {
+    }
+};
+
+template <class... Ts>
+struct flat_tuple : flat_tuple_base<std::index_sequence_for<Ts...>, Ts...>
+{
+    using flat_tuple_base<std::index_sequence_for<Ts...>, Ts...>::flat_tuple_base;
+};
+
+template <class T, std::size_t N>
+struct homogeneous_tuple
+{
+    using value_type = T;
+
+    std::array<T, N> m_values;
+
+    template <class... Us>
+    constexpr explicit homogeneous_tuple(Us... values) : m_values{ { std::move(values)... } }
+    {
+    }
+};
+
+template <class... Ts>
+struct flat_storage
+{
+    using type = flat_tuple<Ts...>;
+};
+
+template <class T, class... Ts>
+struct flat_storage<T, Ts...>
+{
+    using type = std::conditional_t<
+        (sizeof...(Ts) > 0 && all_true<std::is_same_v<T, Ts>...>),
+        homogeneous_tuple<T, sizeof...(Ts) + 1>,
+        flat_tuple<T, Ts...>>;
+};
+
+template <class... Ts>
+using flat_storage_t = typename flat_storage<Ts...>::type;
+
+template <class Storage>
+struct flat_size;
+
+template <class... Ts>
+struct flat_size<flat_tuple<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)>
+{
+};
+
+template <class T, std::size_t N>
+struct flat_size<homogeneous_tuple<T, N>> : std::integral_constant<std::size_t, N>
+{
+};
+
+template <class Storage>
+inline constexpr std::size_t flat_size_v = flat_size<Storage>::value;
+
+template <class T>
+struct is_homogeneous : std::false_type
+{
+};
+
+template <class T, std::size_t N>
+struct is_homogeneous<homogeneous_tuple<T, N>> : std::true_type
+{
+};
+
+template <std::size_t I, class T>
+constexpr const T& flat_get(const flat_leaf<I, T>& leaf)
+{
+    return leaf.m_value;
+}
+
+template <std::size_t I, class T, std::size_t N>
+constexpr const T& flat_get(const homogeneous_tuple<T, N>& storage)
+{
+    return storage.m_values[I];
+}
+
+template <std::size_t I, class Storage>
+using flat_element_t = std::decay_t<decltype(flat_get<I>(std::declval<const Storage&>()))>;
+
+inline constexpr std::size_t fold_chunk_size = 64;
+
+template <bool All, std::size_t Begin, class Func, std::size_t... I>
+constexpr bool index_fold_chunk(Func& func, std::index_sequence<I...>)
+{
+    if constexpr (All)
+    {
+        return (func(std::integral_constant<std::size_t, Begin + I>{}) && ...);
+    }
+    else
+    {
+        return (func(std::integral_constant<std::size_t, Begin + I>{}) || ...);
+    }
+}
+
+template <std::size_t N, std::size_t Chunk>
+using chunk_indices = std::make_index_sequence<std::min(fold_chunk_size, N - Chunk * fold_chunk_size)>;
+
+template <bool All, std::size_t N, class Func, std::size_t... Chunk>
+constexpr bool index_fold(Func& func, std::index_sequence<Chunk...>)
+{
+    if constexpr (All)
+    {
+        return (index_fold_chunk<All, Chunk * fold_chunk_size>(func, chunk_indices<N, Chunk>{}) && ...);
+    }
+    else
+    {
+        return (index_fold_chunk<All, Chunk * fold_chunk_size>(func, chunk_indices<N, Chunk>{}) || ...);
+    }
+}
+
+template <bool All, std::size_t N, class Func>
+constexpr bool index_fold(Func func)
+{
+    return index_fold<All, N>(func, std::make_index_sequence<(N + fold_chunk_size - 1) / fold_chunk_size>{});
+}
+
+template <bool All, std::size_t Begin, class Func, std::size_t... I>
+constexpr bool index_combine_chunk(Func& func, std::index_sequence<I...>)
+{
+    if constexpr (All)
+    {
+        return (All & ... & static_cast<bool>(func(std::integral_constant<std::size_t, Begin + I>{})));
+    }
+    else
+    {
+        return (All | ... | static_cast<bool>(func(std::integral_constant<std::size_t, Begin + I>{})));
+    }
+}
+
+template <bool All, std::size_t N, class Func, std::size_t... Chunk>
+constexpr bool index_combine(Func& func, std::index_sequence<Chunk...>)
+{
+    if constexpr (All)
+    {
+        return (All & ... & index_combine_chunk<All, Chunk * fold_chunk_size>(func, chunk_indices<N, Chunk>{}));
+    }
+    else
+    {
+        return (All | ... | index_combine_chunk<All, Chunk * fold_chunk_size>(func, chunk_indices<N, Chunk>{}));
+    }
+}
+
+template <bool All, std::size_t N, class Func>
+constexpr bool index_combine(Func func)
+{
+    return index_combine<All, N>(func, std::make_index_sequence<(N + fold_chunk_size - 1) / fold_chunk_size>{});
+}
+
+template <class Storage, class Func>
+constexpr void flat_for_each(const Storage& storage, Func func)
+{
+    if constexpr (is_homogeneous<Storage>{})
+    {
+        for (const auto& item : storage.m_values)
+        {
+            func(item);
+        }
+    }
+    else
+    {
+        index_fold<true, flat_size_v<Storage>>(
+            [&](auto i)
+            {
+                func(flat_get<decltype(i)::value>(storage));
+                return true;
+            });
+    }
+}
+
+template <class Func, class Storage, std::size_t... I>
+constexpr decltype(auto) flat_apply(Func&& func, const Storage& storage, std::index_sequence<I...>)
+{
+    return std::forward<Func>(func)(flat_get<I>(storage)...);
+}
+
+template <class Func, class Storage>
+constexpr decltype(auto) flat_apply(Func&& func, const Storage& storage)
+{
+    return flat_apply(std::forward<Func>(func), storage, std::make_index_sequence<flat_size_v<Storage>>{});
+}
+
+struct all_tag
+{
+};
+struct any_tag
+{
+};
+
+struct short_circuit
+{
+};
+struct eager
+{
+};
+struct cost_ordered
+{
+};
+
+template <std::size_t N>
+constexpr auto order_by_cost(const std::array<std::size_t, N>& costs) -> std::array<std::size_t, N>
+{
+    std::array<std::size_t, N> result = {};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        std::size_t j = i;
+        while (j > 0 && costs[i] < costs[result[j - 1]])
+        {
+            result[j] = result[j - 1];
+            --j;
+        }
+        result[j] = i;
+    }
+    return result;
+}
+
+template <class Tag, class Name, class Mode = short_circuit>
+struct compound_fn
+{
+    template <class... Preds>
+    struct impl
+    {
+        using tag_type = Tag;
+        using name_type = Name;
+        using storage_type = flat_storage_t<Preds...>;
+
+        static constexpr bool is_all = std::is_same_v<Tag, all_tag>;
+        static constexpr bool is_eager = std::is_same_v<Mode, eager>;
+        static constexpr bool is_cost_ordered = std::is_same_v<Mode, cost_ordered>;
+        static constexpr std::size_t size = sizeof...(Preds);
+        static constexpr std::size_t cost = (std::size_t{ 0 } + ... + predicate_cost<Preds>());
+        static constexpr std::array<std::size_t, size> evaluation_order
+            = order_by_cost(std::array<std::size_t, size>{ predicate_cost<Preds>()... });
+        static constexpr const void* projection_keys[] = { projection_key<Preds>()..., nullptr };
+
+        storage_type m_preds;
+
+        template <class U>
+        constexpr bool operator()(U&& item) const
+        {
+            if constexpr (
+                !is_all && !is_eager && size > 1 && core::is_detected<valueless_by_exception_t, std::decay_t<U>>{}
+                && all_true<core::is_detected<alternative_of, Preds>::value...>)
+            {
+                return match_variant(m_preds, item);
+            }
+            else if constexpr (is_eager)
+            {
+                return evaluate_eager(item);
+            }
+            else if constexpr (is_cost_ordered && !is_homogeneous<storage_type>{})
+            {
+                return index_fold<is_all, size>(
+                    [&](auto i) { return invoke_pred(flat_get<evaluation_order[decltype(i)::value]>(m_preds), item); });
+            }
+            else if constexpr (is_homogeneous<storage_type>{})
+            {
+                return evaluate_homogeneous(item);
+            }
+            else
+            {
+                return index_fold<is_all, size>([&](auto i) { return evaluate_run<decltype(i)::value>(item); });
+            }
+        }
+
+        static constexpr bool is_run_head(std::size_t i)
+        {
+            return i == 0 || projection_keys[i] == nullptr || projection_keys[i - 1] != projection_keys[i];
+        }
+
+        static constexpr std::size_t run_end(std::size_t i)
+        {
+            std::size_t end = i + 1;
+            while (end < size && projection_keys[i] != nullptr && projection_keys[end] == projection_keys[i])
+            {
+                ++end;
+            }
+            return end;
+        }
+
+        template <std::size_t I, class U>
+        constexpr bool evaluate_run(U& item) const
+        {
+            if constexpr (!is_run_head(I))
+            {
+                return is_all;
+            }
+            else if constexpr (run_end(I) == I + 1)
+            {
+                return invoke_pred(flat_get<I>(m_preds), item);
+            }
+            else
+            {
+                const auto& head = flat_get<I>(m_preds);
+                return with_projection(
+                    head.m_func,
+                    item,
+                    [&](const auto& projected)
+                    {
+                        return index_fold<is_all, run_end(I) - I>(
+                            [&](auto j)
+                            {
+                                const auto& pred = flat_get<I + decltype(j)::value>(m_preds);
+                                return same_projection(pred.m_func, head.m_func) ? invoke_pred(pred.m_pred, projected)
+                                                                                 : invoke_pred(pred, item);
+                            });
+                    });
+            }
+        }
+
+        template <class Func, class U, class Body>
+        static bool with_projection(const Func& func, U& item, Body&& body)
+        {
+            if constexpr (uses_scratch_arena<std::invoke_result_t<const Func&, U&>>())
+            {
+                const evaluation_scope scope;
+                return body(std::invoke(func, item));
+            }
+            else
+            {
+                return body(std::invoke(func, item));
+            }
+        }
+
+        template <class U>
+        constexpr bool evaluate_eager(U& item) const
+        {
+            if constexpr (is_homogeneous<storage_type>{})
+            {
+                bool result = is_all;
+                for (const auto& pred : m_preds.m_values)
+                {
+                    const bool value = invoke_pred(pred, item);
+                    result = is_all ? (result & value) : (result | value);
+                }
+                return result;
+            }
+            else
+            {
+                return index_combine<is_all, size>(
+                    [&](auto i) { return invoke_pred(flat_get<decltype(i)::value>(m_preds), item); });
+            }
+        }
+
+        template <class U>
+        constexpr bool evaluate_homogeneous(U& item) const
+        {
+            using pred_t = typename storage_type::value_type;
+            const pred_t& head = m_preds.m_values[0];
+            if constexpr (projection_key<pred_t>() != nullptr)
+            {
+                return with_projection(
+                    head.m_func,
+                    item,
+                    [&](const auto& projected)
+                    {
+                        for (const pred_t& pred : m_preds.m_values)
+                        {
+                            const bool result = same_projection(pred.m_func, head.m_func)
+                                                    ? invoke_pred(pred.m_pred, projected)
+                                                    : invoke_pred(pred, item);
+                            if (result != is_all)
+                            {
+                                return result;
+                            }
+                        }
+                        return is_all;
+                    });
+            }
+            else
+            {
+                for (const pred_t& pred : m_preds.m_values)
+                {
+                    if (invoke_pred(pred, item) != is_all)
+                    {
+                        return !is_all;
+                    }
+                }
+            }
+            return is_all;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            static const auto name = Name{};
+
+            os << "(" << name;
+            flat_for_each(item.m_preds, [&](const auto& pred) { os << " " << ::ferrugo::core::safe_format(pred); });
+            os << ")";
+            return os;
+        }
+    };
+
+    template <class Pipe>
+    static constexpr bool is_nested(const Pipe*)
+    {
+        return false;
+    }
+
+    template <class... Pipes>
+    static constexpr bool is_nested(const impl<Pipes...>*)
+    {
+        return true;
+    }
+
+    template <class Pipe>
+    auto to_tuple(Pipe pipe) const -> std::tuple<Pipe>
+    {
+        return std::tuple<Pipe>{ std::move(pipe) };
+    }
+
+    template <class... Pipes>
+    auto to_tuple(impl<Pipes...> pipe) const -> std::tuple<Pipes...>
+    {
+        return flat_apply([](const auto&... preds) { return std::tuple<Pipes...>{ preds... }; }, pipe.m_preds);
+    }
+
+    template <class... Pipes>
+    auto from_tuple(std::tuple<Pipes...> tuple) const -> impl<Pipes...>
+    {
+        return std::apply(
+            [](Pipes&... preds) { return impl<Pipes...>{ flat_storage_t<Pipes...>{ std::move(preds)... } }; }, tuple);
+    }
+
+    template <class... Pipes>
+    auto operator()(Pipes... pipes) const
+    {
+        if constexpr (all_true<!is_nested(static_cast<const Pipes*>(nullptr))...>)
+        {
+            return impl<Pipes...>{ flat_storage_t<Pipes...>{ std::move(pipes)... } };
+        }
+        else
+        {
+            return from_tuple(std::tuple_cat(to_tuple(std::move(pipes))...));
+        }
+    }
+};
+
+struct negate_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        static constexpr std::size_t cost = predicate_cost<Pred>();
+
+        Pred m_pred;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return !invoke_pred(m_pred, std::forward<U>(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(not " << item.m_pred << ")";
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred&& pred) const -> impl<std::decay_t<Pred>>
+    {
+        return impl<std::decay_t<Pred>>{ std::forward<Pred>(pred) };
+    }
+};
+
+struct is_some_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        static constexpr std::size_t cost = 1 + predicate_cost<Pred>();
+
+        Pred m_pred;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return static_cast<bool>(item) && invoke_pred(m_pred, *std::forward<U>(item));
+        }
+
+        bool operator()(nullptr_t) const
+        {
+            return false;
+        }
+
+        bool operator()(std::nullopt_t) const
+        {
+            return false;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_some " << item.m_pred << ")";
+        }
+    };
+
+    struct void_impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return static_cast<bool>(item);
+        }
+
+        bool operator()(nullptr_t) const
+        {
+            return false;
+        }
+
+        bool operator()(std::nullopt_t) const
+        {
+            return false;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const void_impl& item)
+        {
+            return os << "(is_some)";
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred&& pred) const -> impl<std::decay_t<Pred>>
+    {
+        return impl<std::decay_t<Pred>>{ std::forward<Pred>(pred) };
+    }
+
+    auto operator()() const -> void_impl
+    {
+        return void_impl{};
+    }
+};
+
+struct is_none_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return !static_cast<bool>(item);
+        }
+
+        bool operator()(nullptr_t) const
+        {
+            return true;
+        }
+
+        bool operator()(std::nullopt_t) const
+        {
+            return true;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_none)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+
+template <class Op, class Name>
+struct compare_fn
+{
+    template <class T>
+    struct impl
+    {
+        using operator_type = Op;
+        using name_type = Name;
+        static constexpr std::size_t cost = std::is_arithmetic_v<T> ? 1 : 4;
+
+        T m_value;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            static const auto op = Op{};
+            return op(std::forward<U>(item), m_value);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            static const auto name = Name{};
+            return os << "(" << name << " " << item.m_value << ")";
+        }
+    };
+
+    template <class T>
+    auto operator()(T&& value) const -> impl<std::decay_t<T>>
+    {
+        return impl<std::decay_t<T>>{ std::forward<T>(value) };
+    }
+};
+
+template <class Name>
+struct result_of_fn
+{
+    template <class Func, class Pred>
+    struct impl
+    {
+        using projection_type = Func;
+        using name_type = Name;
+        static constexpr std::size_t cost = 1 + predicate_cost<Pred>();
+
+        Func m_func;
+        Pred m_pred;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            if constexpr (uses_scratch_arena<std::invoke_result_t<const Func&, U>>())
+            {
+                const evaluation_scope scope;
+                return invoke_pred(m_pred, std::invoke(m_func, std::forward<U>(item)));
+            }
+            else
+            {
+                return invoke_pred(m_pred, std::invoke(m_func, std::forward<U>(item)));
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            static const auto name = Name{};
+            return os << "(" << name << " " << ::ferrugo::core::safe_format(item.m_func) << " "
+                      << ::ferrugo::core::safe_format(item.m_pred) << ")";
+        }
+    };
+
+    template <class Func, class Pred>
+    auto operator()(Func&& func, Pred&& pred) const -> impl<std::decay_t<Func>, std::decay_t<Pred>>
+    {
+        return { std::forward<Func>(func), std::forward<Pred>(pred) };
+    }
+};
+
+template <std::size_t N>
+struct field_at_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        static constexpr std::size_t field_index = N;
+        static constexpr std::size_t cost = predicate_cost<Pred>();
+
+        Pred pred;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return invoke_pred(pred, std::get<N>(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(element " << N << " " << item.pred << ")";
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred&& pred) const -> impl<std::decay_t<Pred>>
+    {
+        return impl<std::decay_t<Pred>>{ std::forward<Pred>(pred) };
+    }
+};
+
+struct fields_are_fn
+{
+    template <class... Preds>
+    struct impl
+    {
+        static constexpr std::size_t cost = (std::size_t{ 0 } + ... + predicate_cost<Preds>());
+
+        std::tuple<Preds...> m_preds;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return call(std::forward<U>(item), std::index_sequence_for<Preds...>{});
+        }
+
+        template <class U, std::size_t... I>
+        bool call(U&& item, std::index_sequence<I...>) const
+        {
+            return (invoke_pred(std::get<I>(m_preds), std::get<I>(std::forward<U>(item))) && ...);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            os << "("
+               << "elements_are";
+            std::apply(
+                [&](const auto&... preds) { ((os << " " << ::ferrugo::core::safe_format(preds)), ...); }, item.m_preds);
+            os << ")";
+            return os;
+        }
+    };
+
+    template <class... Preds>
+    auto operator()(Preds&&... preds) const -> impl<std::decay_t<Preds>...>
+    {
+        return impl<std::decay_t<Preds>...>{ { std::forward<Preds>(preds)... } };
+    }
+};
+
+}  // namespace detail
+
+inline constexpr auto any = detail::compound_fn<detail::any_tag, FERRUGO_STR_T("any")>{};
+inline constexpr auto all = detail::compound_fn<detail::all_tag, FERRUGO_STR_T("all")>{};
+inline constexpr auto any_eager = detail::compound_fn<detail::any_tag, FERRUGO_STR_T("any_eager"), detail::eager>{};
+inline constexpr auto all_eager = detail::compound_fn<detail::all_tag, FERRUGO_STR_T("all_eager"), detail::eager>{};
+inline constexpr auto any_by_cost = detail::compound_fn<detail::any_tag, FERRUGO_STR_T("any"), detail::cost_ordered>{};
+inline constexpr auto all_by_cost = detail::compound_fn<detail::all_tag, FERRUGO_STR_T("all"), detail::cost_ordered>{};
+inline constexpr auto negate = detail::negate_fn{};
+
+inline constexpr auto is_some = detail::is_some_fn{};
+inline constexpr auto is_none = detail::is_none_fn{};
+
+inline constexpr auto eq = detail::compare_fn<std::equal_to<>, FERRUGO_STR_T("eq")>{};
+inline constexpr auto ne = detail::compare_fn<std::not_equal_to<>, FERRUGO_STR_T("ne")>{};
+inline constexpr auto lt = detail::compare_fn<std::less<>, FERRUGO_STR_T("lt")>{};
+inline constexpr auto gt = detail::compare_fn<std::greater<>, FERRUGO_STR_T("gt")>{};
+inline constexpr auto le = detail::compare_fn<std::less_equal<>, FERRUGO_STR_T("le")>{};
+inline constexpr auto ge = detail::compare_fn<std::greater_equal<>, FERRUGO_STR_T("ge")>{};
+
+inline constexpr auto result_of = detail::result_of_fn<FERRUGO_STR_T("result_of")>{};
+inline constexpr auto field = detail::result_of_fn<FERRUGO_STR_T("field")>{};
+inline constexpr auto property = detail::result_of_fn<FERRUGO_STR_T("property")>{};
+
+template <std::size_t N>
+inline constexpr auto element = detail::field_at_fn<N>{};
+
+inline constexpr auto elements_are = detail::fields_are_fn{};
+
+template <class Pred>
+inline constexpr std::size_t static_cost_v = detail::predicate_cost<Pred>();
+
+}  // namespace predicates
+}  // namespace ferrugo
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/predicates/containers.hpp>
+#include <ferrugo/predicates/core.hpp>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+namespace detail
+{
+
+template <char... C>
+inline constexpr char name_chars[] = { C..., '\0' };
+
+template <template <char...> class Str, char... C>
+constexpr std::string_view name_view(const Str<C...>&)
+{
+    return std::string_view{ name_chars<C...>, sizeof...(C) };
+}
+
+template <class Pred>
+using name_of = typename Pred::name_type;
+
+template <class Pred>
+struct unary_label
+{
+    static constexpr std::string_view value = {};
+};
+
+template <class Pred>
+struct unary_label<negate_fn::impl<Pred>>
+{
+    static constexpr std::string_view value = "not";
+};
+
+template <class Pred>
+struct unary_label<is_some_fn::impl<Pred>>
+{
+    static constexpr std::string_view value = "is_some";
+};
+
+template <class Pred>
+struct unary_label<size_is_fn::impl<Pred>>
+{
+    static constexpr std::string_view value = "size_is";
+};
+
+template <class Pred>
+struct unary_label<each_item_fn::impl<Pred>>
+{
+    static constexpr std::string_view value = "each_item";
+};
+
+template <class Pred>
+struct unary_label<contains_item_fn::impl<Pred>>
+{
+    static constexpr std::string_view value = "contains_item";
+};
+
+template <class Pred>
+struct tuple_label
+{
+    static constexpr std::string_view value = {};
+};
+
+template <class... Preds>
+struct tuple_label<fields_are_fn::impl<Preds...>>
+{
+    static constexpr std::string_view value = "elements_are";
+};
+
+template <class... Preds>
+struct tuple_label<items_are_fn::impl<Preds...>>
+{
+    static constexpr std::string_view value = "items_are";
+};
+
+template <class... Preds>
+struct tuple_label<starts_with_items_fn::impl<Preds...>>
+{
+    static constexpr std::string_view value = "starts_with_items";
+};
+
+template <class... Preds>
+struct tuple_label<ends_with_items_fn::impl<Preds...>>
+{
+    static constexpr std::string_view value = "ends_with_items";
+};
+
+template <class... Preds>
+struct tuple_label<contains_items_fn::impl<Preds...>>
+{
+    static constexpr std::string_view value = "contains_items";
+};
+
+template <class T>
+std::string render_with_stream(const T& value)
+{
+    std::stringstream ss;
+    ss << ::ferrugo::core::safe_format(value);
+    return ss.str();
+}
+
+template <class Out>
+Out write_text(Out out, std::string_view text)
+{
+    return std::copy(text.begin(), text.end(), out);
+}
+
+struct string_appender
+{
+    std::string* m_out;
+};
+
+inline string_appender write_text(string_appender out, std::string_view text)
+{
+    out.m_out->append(text);
+    return out;
+}
+
+template <class Out, class T>
+Out write_value(Out out, const T& value)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return write_text(out, value ? "1" : "0");
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+        return write_text(out, std::string_view{ &value, 1 });
+    }
+    else if constexpr (std::is_integral_v<T> && sizeof(T) > 1)
+    {
+        char buffer[24];
+        const auto res = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        return write_text(out, std::string_view{ buffer, static_cast<std::size_t>(res.ptr - buffer) });
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        char buffer[64];
+        const auto res = std::to_chars(std::begin(buffer), std::end(buffer), value, std::chars_format::general, 6);
+        return write_text(out, std::string_view{ buffer, static_cast<std::size_t>(res.ptr - buffer) });
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+    {
+        return write_text(out, std::string_view{ value });
+    }
+    else if constexpr (std::is_empty_v<T>)
+    {
+        static const std::string text = render_with_stream(value);
+        return write_text(out, text);
+    }
+    else
+    {
+        return write_text(out, render_with_stream(value));
+    }
+}
+
+template <class Pred>
+using description_of = decltype(std::declval<const Pred&>().description());
+
+// Leaf predicates declare a `write_description(out, item)` friend next to their `operator<<`; it is found by ADL.
+template <class Out, class Pred>
+using write_description_of = decltype(write_description(std::declval<Out>(), std::declval<const Pred&>()));
+
+struct format_to_fn
+{
+    template <class Out, class Pred>
+    Out operator()(Out out, const Pred& pred) const
+    {
+        if constexpr (core::is_detected<name_of, Pred>{} && core::is_detected<compound_tag_of, Pred>{})
+        {
+            out = write_text(write_text(out, "("), name_view(name_of<Pred>{}));
+            flat_for_each(pred.m_preds, [&](const auto& child) { out = (*this)(write_text(out, " "), child); });
+            return write_text(out, ")");
+        }
+        else if constexpr (core::is_detected<name_of, Pred>{} && core::is_detected<compare_operator_of, Pred>{})
+        {
+            out = write_text(write_text(out, "("), name_view(name_of<Pred>{}));
+            return write_text(write_value(write_text(out, " "), pred.m_value), ")");
+        }
+        else if constexpr (core::is_detected<name_of, Pred>{} && core::is_detected<projection_of, Pred>{})
+        {
+            out = write_text(write_text(out, "("), name_view(name_of<Pred>{}));
+            out = write_value(write_text(out, " "), pred.m_func);
+            return write_text((*this)(write_text(out, " "), pred.m_pred), ")");
+        }
+        else if constexpr (core::is_detected<field_index_of, Pred>{})
+        {
+            out = write_value(write_text(out, "(element "), Pred::field_index);
+            return write_text((*this)(write_text(out, " "), pred.pred), ")");
+        }
+        else if constexpr (!unary_label<Pred>::value.empty())
+        {
+            out = write_text(write_text(out, "("), unary_label<Pred>::value);
+            return write_text((*this)(write_text(out, " "), pred.m_pred), ")");
+        }
+        else if constexpr (!tuple_label<Pred>::value.empty())
+        {
+            out = write_text(write_text(out, "("), tuple_label<Pred>::value);
+            std::apply(
+                [&](const auto&... children) { ((out = (*this)(write_text(out, " "), children)), ...); }, pred.m_preds);
+            return write_text(out, ")");
+        }
+        else if constexpr (core::is_detected<write_description_of, Out, Pred>{})
+        {
+            return write_description(out, pred);
+        }
+        else if constexpr (core::is_detected<description_of, Pred>{})
+        {
+            return write_text(out, pred.description());
+        }
+        else
+        {
+            return write_value(out, pred);
+        }
+    }
+};
+
+struct append_description_fn
+{
+    template <class Pred>
+    void operator()(std::string& out, const Pred& pred) const
+    {
+        format_to_fn{}(string_appender{ &out }, pred);
+    }
+};
+
+struct described_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        Pred m_pred;
+        std::string m_description;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return invoke_pred(m_pred, std::forward<U>(item));
+        }
+
+        std::string_view description() const
+        {
+            return m_description;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << item.m_description;
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred pred) const -> impl<Pred>
+    {
+        std::string description;
+        append_description_fn{}(description, pred);
+        return impl<Pred>{ std::move(pred), std::move(description) };
+    }
+};
+
+}  // namespace detail
+
+inline constexpr auto format_to = detail::format_to_fn{};
+inline constexpr auto append_description = detail::append_description_fn{};
+inline constexpr auto described = detail::described_fn{};
+
+}  // namespace predicates
+}  // namespace ferrugo
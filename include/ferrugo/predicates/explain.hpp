@@ -0,0 +1,223 @@
+#pragma once
+
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/predicates/containers.hpp>
+#include <ferrugo/predicates/core.hpp>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+struct mismatch
+{
+    std::vector<std::string> path;
+    std::string predicate;
+    std::string value;
+
+    friend std::ostream& operator<<(std::ostream& os, const mismatch& item)
+    {
+        if (!item.path.empty())
+        {
+            os << "at ";
+            for (std::size_t i = 0; i < item.path.size(); ++i)
+            {
+                os << (i != 0 ? " > " : "") << item.path[i];
+            }
+            os << ": ";
+        }
+        return os << item.value << " does not match " << item.predicate;
+    }
+};
+
+namespace detail
+{
+
+template <class Pred>
+struct is_each_item : std::false_type
+{
+};
+
+template <class Pred>
+struct is_each_item<each_item_fn::impl<Pred>> : std::true_type
+{
+};
+
+template <class Pred>
+struct is_size_is : std::false_type
+{
+};
+
+template <class Pred>
+struct is_size_is<size_is_fn::impl<Pred>> : std::true_type
+{
+};
+
+template <class Pred>
+struct is_items_are : std::false_type
+{
+};
+
+template <class... Preds>
+struct is_items_are<items_are_fn::impl<Preds...>> : std::true_type
+{
+};
+
+template <class Pred>
+struct is_fields_are : std::false_type
+{
+};
+
+template <class... Preds>
+struct is_fields_are<fields_are_fn::impl<Preds...>> : std::true_type
+{
+};
+
+template <class... Args>
+std::string format_text(const Args&... args)
+{
+    std::stringstream ss;
+    (ss << ... << args);
+    return ss.str();
+}
+
+struct explain_fn
+{
+    template <class Pred, class T>
+    static void leaf(const Pred& pred, const T& value, mismatch& result)
+    {
+        result.predicate = format_text(::ferrugo::core::safe_format(pred));
+        result.value = format_text(::ferrugo::core::safe_format(value));
+    }
+
+    template <class Pred, class T>
+    static bool visit_child(const Pred& pred, const T& value, std::string step, mismatch& result)
+    {
+        if (invoke_pred(pred, value))
+        {
+            return false;
+        }
+        result.path.push_back(std::move(step));
+        descend(pred, value, result);
+        return true;
+    }
+
+    template <class Preds, class T, std::size_t... I>
+    static bool visit_fields(const Preds& preds, const T& value, mismatch& result, std::index_sequence<I...>)
+    {
+        return (visit_child(std::get<I>(preds), std::get<I>(value), "element " + std::to_string(I), result) || ...);
+    }
+
+    template <class Preds, class Iter, std::size_t... I>
+    static bool visit_items(const Preds& preds, Iter it, mismatch& result, std::index_sequence<I...>)
+    {
+        return (visit_child(std::get<I>(preds), *std::next(it, I), "item " + std::to_string(I), result) || ...);
+    }
+
+    template <class Pred, class T>
+    static void descend(const Pred& pred, const T& value, mismatch& result)
+    {
+        if constexpr (core::is_detected<compound_tag_of, Pred>{})
+        {
+            bool found = false;
+            std::size_t index = 0;
+            if constexpr (std::is_same_v<compound_tag_of<Pred>, all_tag>)
+            {
+                flat_for_each(
+                    pred.m_preds,
+                    [&](const auto& child)
+                    { found = found || visit_child(child, value, "all #" + std::to_string(index++), result); });
+            }
+            if (!found)
+            {
+                leaf(pred, value, result);
+            }
+        }
+        else if constexpr (core::is_detected<projection_of, Pred>{})
+        {
+            static const auto name = typename Pred::name_type{};
+            const std::string step = format_text(name, " ", ::ferrugo::core::safe_format(pred.m_func));
+            if (!visit_child(pred.m_pred, std::invoke(pred.m_func, value), step, result))
+            {
+                leaf(pred, value, result);
+            }
+        }
+        else if constexpr (core::is_detected<field_index_of, Pred>{})
+        {
+            const std::string step = "element " + std::to_string(Pred::field_index);
+            if (!visit_child(pred.pred, std::get<Pred::field_index>(value), step, result))
+            {
+                leaf(pred, value, result);
+            }
+        }
+        else if constexpr (is_fields_are<Pred>{})
+        {
+            constexpr std::size_t size = std::tuple_size_v<decltype(pred.m_preds)>;
+            if (!visit_fields(pred.m_preds, value, result, std::make_index_sequence<size>{}))
+            {
+                leaf(pred, value, result);
+            }
+        }
+        else if constexpr (is_each_item<Pred>{})
+        {
+            std::size_t index = 0;
+            for (const auto& item : value)
+            {
+                if (visit_child(pred.m_pred, item, "item " + std::to_string(index++), result))
+                {
+                    return;
+                }
+            }
+            leaf(pred, value, result);
+        }
+        else if constexpr (is_size_is<Pred>{})
+        {
+            const auto size = static_cast<std::ptrdiff_t>(std::distance(std::begin(value), std::end(value)));
+            if (!visit_child(pred.m_pred, size, "size", result))
+            {
+                leaf(pred, value, result);
+            }
+        }
+        else if constexpr (is_items_are<Pred>{})
+        {
+            constexpr std::size_t size = std::tuple_size_v<decltype(pred.m_preds)>;
+            if (static_cast<std::size_t>(std::distance(std::begin(value), std::end(value))) != size
+                || !visit_items(pred.m_preds, std::begin(value), result, std::make_index_sequence<size>{}))
+            {
+                leaf(pred, value, result);
+            }
+        }
+        else
+        {
+            leaf(pred, value, result);
+        }
+    }
+
+    template <class Pred, class T>
+    auto operator()(const Pred& pred, const T& value) const -> std::optional<mismatch>
+    {
+        if (invoke_pred(pred, value))
+        {
+            return std::nullopt;
+        }
+        mismatch result;
+        descend(pred, value, result);
+        return result;
+    }
+};
+
+}  // namespace detail
+
+inline constexpr auto explain = detail::explain_fn{};
+
+}  // namespace predicates
+}  // namespace ferrugo
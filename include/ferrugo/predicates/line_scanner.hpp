@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <ferrugo/predicates/mapped_file.hpp>
+#include <ferrugo/predicates/core.hpp>
+#include <numeric>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+struct scan_options
+{
+    std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t min_chunk_size = std::size_t(1) << 20;
+};
+
+namespace detail
+{
+
+inline auto split_lines_into_chunks(std::string_view text, const scan_options& options) -> std::vector<std::string_view>
+{
+    const std::size_t max_chunks = std::max<std::size_t>(1, text.size() / std::max<std::size_t>(1, options.min_chunk_size));
+    const std::size_t chunk_count = std::min(std::max<std::size_t>(1, options.thread_count), max_chunks);
+    const std::size_t chunk_size = text.size() / chunk_count;
+
+    std::vector<std::string_view> result;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < chunk_count && begin < text.size(); ++i)
+    {
+        std::size_t end = text.size();
+        if (i + 1 < chunk_count)
+        {
+            const std::size_t newline = text.find('\n', std::max(begin, (i + 1) * chunk_size));
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        result.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return result;
+}
+
+template <class Pred, class Func>
+void for_each_line(std::string_view chunk, const Pred& pred, Func&& func)
+{
+    const char* const chunk_end = chunk.data() + chunk.size();
+    const char* line = chunk.data();
+    while (line != chunk_end)
+    {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', chunk_end - line));
+        const char* line_end = newline ? newline : chunk_end;
+        if (invoke_pred(pred, std::string_view{ line, static_cast<std::size_t>(line_end - line) }))
+        {
+            func(line);
+        }
+        line = newline ? newline + 1 : chunk_end;
+    }
+}
+
+struct joining_threads
+{
+    std::vector<std::thread>& m_threads;
+
+    ~joining_threads()
+    {
+        for (std::thread& thread : m_threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+    }
+};
+
+template <class Result, class Scan>
+auto scan_chunks(std::string_view text, const scan_options& options, Scan scan) -> std::vector<Result>
+{
+    const std::vector<std::string_view> chunks = split_lines_into_chunks(text, options);
+    std::vector<Result> results(chunks.size());
+    if (chunks.size() == 1)
+    {
+        scan(chunks[0], results[0]);
+        return results;
+    }
+    std::vector<std::exception_ptr> errors(chunks.size());
+    std::vector<std::thread> threads;
+    {
+        const joining_threads joiner{ threads };
+        threads.reserve(chunks.size());
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            threads.emplace_back(
+                [&, i]()
+                {
+                    try
+                    {
+                        scan(chunks[i], results[i]);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                });
+        }
+    }
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+    return results;
+}
+
+}  // namespace detail
+
+template <class Pred>
+auto find_lines(std::string_view text, const Pred& pred, const scan_options& options = {}) -> std::vector<std::size_t>
+{
+    const auto chunks = detail::scan_chunks<std::vector<std::size_t>>(
+        text,
+        options,
+        [&](std::string_view chunk, std::vector<std::size_t>& out)
+        { detail::for_each_line(chunk, pred, [&](const char* line) { out.push_back(line - text.data()); }); });
+
+    std::vector<std::size_t> result;
+    for (const auto& offsets : chunks)
+    {
+        result.insert(result.end(), offsets.begin(), offsets.end());
+    }
+    return result;
+}
+
+template <class Pred>
+auto count_lines(std::string_view text, const Pred& pred, const scan_options& options = {}) -> std::size_t
+{
+    const auto chunks = detail::scan_chunks<std::size_t>(
+        text,
+        options,
+        [&](std::string_view chunk, std::size_t& out) { detail::for_each_line(chunk, pred, [&](const char*) { ++out; }); });
+    return std::accumulate(chunks.begin(), chunks.end(), std::size_t(0));
+}
+
+inline auto line_at(std::string_view text, std::size_t offset) -> std::string_view
+{
+    const std::size_t end = text.find('\n', offset);
+    return text.substr(offset, end == std::string_view::npos ? std::string_view::npos : end - offset);
+}
+
+}  // namespace predicates
+}  // namespace ferrugo
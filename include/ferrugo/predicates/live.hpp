@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ferrugo/predicates/rule_set.hpp>
+#include <ferrugo/predicates/type_erasure.hpp>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+namespace detail
+{
+
+class epoch_domain
+{
+public:
+    static constexpr std::size_t max_readers = 256;
+
+    class guard
+    {
+    public:
+        explicit guard(std::atomic<std::uint64_t>& slot) : m_slot{ &slot }
+        {
+        }
+
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+
+        ~guard()
+        {
+            m_slot->store(0, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<std::uint64_t>* m_slot;
+    };
+
+    guard enter()
+    {
+        static thread_local const std::size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        for (std::size_t i = hint;; ++i)
+        {
+            std::atomic<std::uint64_t>& slot = m_slots[i % max_readers].m_epoch;
+            std::uint64_t expected = 0;
+            if (slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(expected, m_epoch.load()))
+            {
+                return guard{ slot };
+            }
+        }
+    }
+
+    std::uint64_t advance()
+    {
+        return m_epoch.fetch_add(1);
+    }
+
+    bool is_quiescent(std::uint64_t epoch) const
+    {
+        for (const slot& s : m_slots)
+        {
+            const std::uint64_t active = s.m_epoch.load();
+            if (active != 0 && active <= epoch)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    struct alignas(64) slot
+    {
+        std::atomic<std::uint64_t> m_epoch{ 0 };
+    };
+
+    std::atomic<std::uint64_t> m_epoch{ 1 };
+    std::array<slot, max_readers> m_slots;
+};
+
+}  // namespace detail
+
+template <class Value>
+class live
+{
+public:
+    explicit live(Value value) : m_current{ new node{ std::move(value), 0 } }
+    {
+    }
+
+    live(const live&) = delete;
+    live& operator=(const live&) = delete;
+
+    ~live()
+    {
+        delete m_current.load();
+        for (const retired& r : m_retired)
+        {
+            delete r.m_node;
+        }
+    }
+
+    void publish(Value value)
+    {
+        node* next = new node{ std::move(value), 0 };
+        const std::lock_guard<std::mutex> lock{ m_write_mutex };
+        next->m_version = m_current.load()->m_version + 1;
+        node* previous = m_current.exchange(next);
+        m_retired.push_back(retired{ previous, m_domain.advance() });
+        reclaim_retired();
+    }
+
+    template <class Func>
+    auto read(Func&& func) const
+    {
+        const auto guard = m_domain.enter();
+        return std::invoke(std::forward<Func>(func), std::as_const(m_current.load()->m_value));
+    }
+
+    std::size_t version() const
+    {
+        const auto guard = m_domain.enter();
+        return m_current.load()->m_version;
+    }
+
+    std::size_t pending_reclamation() const
+    {
+        const std::lock_guard<std::mutex> lock{ m_write_mutex };
+        return m_retired.size();
+    }
+
+    void reclaim()
+    {
+        const std::lock_guard<std::mutex> lock{ m_write_mutex };
+        reclaim_retired();
+    }
+
+private:
+    struct node
+    {
+        Value m_value;
+        std::size_t m_version;
+    };
+
+    struct retired
+    {
+        node* m_node;
+        std::uint64_t m_epoch;
+    };
+
+    void reclaim_retired()
+    {
+        const auto end = std::partition(
+            m_retired.begin(), m_retired.end(), [&](const retired& r) { return !m_domain.is_quiescent(r.m_epoch); });
+        for (auto it = end; it != m_retired.end(); ++it)
+        {
+            delete it->m_node;
+        }
+        m_retired.erase(end, m_retired.end());
+    }
+
+    mutable detail::epoch_domain m_domain;
+    std::atomic<node*> m_current;
+    mutable std::mutex m_write_mutex;
+    std::vector<retired> m_retired;
+};
+
+template <class T>
+class live_predicate
+{
+public:
+    explicit live_predicate(predicate<T> pred) : m_pred{ std::move(pred) }
+    {
+    }
+
+    bool operator()(::ferrugo::core::in_t<T> item) const
+    {
+        return m_pred.read([&](const predicate<T>& pred) { return pred(item); });
+    }
+
+    void publish(predicate<T> pred)
+    {
+        m_pred.publish(std::move(pred));
+    }
+
+    std::size_t version() const
+    {
+        return m_pred.version();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const live_predicate& item)
+    {
+        return os << "live_predicate<" << ::ferrugo::core::type_name<T>() << ">";
+    }
+
+private:
+    live<predicate<T>> m_pred;
+};
+
+template <class T>
+class live_rule_set
+{
+public:
+    using rule_id = typename rule_set<T>::rule_id;
+
+    explicit live_rule_set(rule_set<T> rules) : m_rules{ std::move(rules) }
+    {
+    }
+
+    void match(const T& item, std::vector<rule_id>& out) const
+    {
+        m_rules.read([&](const rule_set<T>& rules) { rules.match(item, out); });
+    }
+
+    auto match(const T& item) const -> std::vector<rule_id>
+    {
+        return m_rules.read([&](const rule_set<T>& rules) { return rules.match(item); });
+    }
+
+    void publish(rule_set<T> rules)
+    {
+        m_rules.publish(std::move(rules));
+    }
+
+    std::size_t version() const
+    {
+        return m_rules.version();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const live_rule_set& item)
+    {
+        return os << "live_rule_set<" << ::ferrugo::core::type_name<T>() << ">";
+    }
+
+private:
+    live<rule_set<T>> m_rules;
+};
+
+}  // namespace predicates
+}  // namespace ferrugo
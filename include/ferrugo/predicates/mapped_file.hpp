@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+enum class access_pattern
+{
+    normal,
+    sequential
+};
+
+class mapped_file
+{
+public:
+    explicit mapped_file(const std::string& path, access_pattern pattern = access_pattern::normal)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::system_error{ errno, std::generic_category(), path };
+        }
+        struct stat st = {};
+        if (::fstat(fd, &st) != 0)
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error{ error, std::generic_category(), path };
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+        if (m_size > 0)
+        {
+            void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error{ error, std::generic_category(), path };
+            }
+            if (pattern == access_pattern::sequential)
+            {
+                ::madvise(data, m_size, MADV_SEQUENTIAL);
+            }
+            m_data = static_cast<const char*>(data);
+        }
+        ::close(fd);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept
+        : m_data{ std::exchange(other.m_data, nullptr) }
+        , m_size{ std::exchange(other.m_size, 0) }
+    {
+    }
+
+    mapped_file& operator=(mapped_file&& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+
+    ~mapped_file()
+    {
+        if (m_data)
+        {
+            ::munmap(const_cast<char*>(m_data), m_size);
+        }
+    }
+
+    std::string_view contents() const
+    {
+        return std::string_view{ m_data, m_size };
+    }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+}  // namespace predicates
+}  // namespace ferrugo
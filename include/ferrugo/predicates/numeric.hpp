@@ -0,0 +1,409 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ferrugo/predicates/core.hpp>
+#include <ferrugo/predicates/description.hpp>
+#include <limits>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+enum class tolerance_mode
+{
+    absolute,
+    relative,
+    ulp
+};
+
+struct tolerance
+{
+    tolerance_mode mode;
+    double amount;
+
+    friend bool operator==(const tolerance& lhs, const tolerance& rhs)
+    {
+        return lhs.mode == rhs.mode && lhs.amount == rhs.amount;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const tolerance& item)
+    {
+        switch (item.mode)
+        {
+            case tolerance_mode::absolute: return os << "(abs " << item.amount << ")";
+            case tolerance_mode::relative: return os << "(rel " << item.amount << ")";
+            case tolerance_mode::ulp: return os << "(ulp " << item.amount << ")";
+        }
+        return os;
+    }
+
+    template <class Out>
+    friend Out write_description(Out out, const tolerance& item)
+    {
+        switch (item.mode)
+        {
+            case tolerance_mode::absolute: out = detail::write_text(out, "(abs "); break;
+            case tolerance_mode::relative: out = detail::write_text(out, "(rel "); break;
+            case tolerance_mode::ulp: out = detail::write_text(out, "(ulp "); break;
+        }
+        return detail::write_text(detail::write_value(out, item.amount), ")");
+    }
+};
+
+constexpr tolerance absolute_tolerance(double amount)
+{
+    return tolerance{ tolerance_mode::absolute, amount };
+}
+
+constexpr tolerance relative_tolerance(double amount)
+{
+    return tolerance{ tolerance_mode::relative, amount };
+}
+
+constexpr tolerance ulp_tolerance(std::uint32_t amount)
+{
+    return tolerance{ tolerance_mode::ulp, static_cast<double>(amount) };
+}
+
+namespace detail
+{
+
+template <class T>
+using ordered_bits_t = std::conditional_t<sizeof(T) == sizeof(std::int32_t), std::int32_t, std::int64_t>;
+
+template <class T>
+inline auto ulp_distance(T lhs, T rhs) -> std::make_unsigned_t<ordered_bits_t<T>>
+{
+    using bits_t = ordered_bits_t<T>;
+    using unsigned_t = std::make_unsigned_t<bits_t>;
+    static_assert(sizeof(bits_t) == sizeof(T), "unsupported floating point type");
+    const auto ordered = [](T value) -> bits_t
+    {
+        bits_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits < 0 ? std::numeric_limits<bits_t>::min() - bits : bits;
+    };
+    const bits_t l = ordered(lhs);
+    const bits_t r = ordered(rhs);
+    return l < r ? unsigned_t(r) - unsigned_t(l) : unsigned_t(l) - unsigned_t(r);
+}
+
+struct approx_eq_fn
+{
+    template <class T>
+    struct impl
+    {
+        static constexpr std::size_t cost = 2;
+
+        T m_value;
+        tolerance m_tolerance;
+
+        template <tolerance_mode Mode, class V>
+        static bool test(const V& item, const T& value, double amount)
+        {
+            using common_t = std::common_type_t<V, T>;
+            const common_t x = item;
+            const common_t v = value;
+            if constexpr (Mode == tolerance_mode::ulp)
+            {
+                using distance_t = decltype(ulp_distance(x, v));
+                const distance_t limit = amount < double(std::numeric_limits<distance_t>::max())
+                                             ? distance_t(amount)
+                                             : std::numeric_limits<distance_t>::max();
+                return (x == v) | (!std::isnan(x) & !std::isnan(v) & (ulp_distance(x, v) <= limit));
+            }
+            else if constexpr (Mode == tolerance_mode::relative)
+            {
+                const common_t ax = std::abs(x);
+                const common_t av = std::abs(v);
+                return (x == v) | (std::abs(x - v) < common_t(amount) * (ax < av ? av : ax));
+            }
+            else
+            {
+                return (x == v) | (std::abs(x - v) < common_t(amount));
+            }
+        }
+
+        template <class V>
+        bool test(const V& item) const
+        {
+            switch (m_tolerance.mode)
+            {
+                case tolerance_mode::absolute: return test<tolerance_mode::absolute>(item, m_value, m_tolerance.amount);
+                case tolerance_mode::relative: return test<tolerance_mode::relative>(item, m_value, m_tolerance.amount);
+                case tolerance_mode::ulp: return test<tolerance_mode::ulp>(item, m_value, m_tolerance.amount);
+            }
+            return false;
+        }
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            return test(item);
+        }
+
+        template <bool All, tolerance_mode Mode, class V>
+        bool scan(const V* data, std::size_t size) const
+        {
+            const T value = m_value;
+            const double amount = m_tolerance.amount;
+            return batch_scan<All>(data, size, [value, amount](const V& item) { return test<Mode>(item, value, amount); });
+        }
+
+        template <bool All, class V>
+        bool scan(const V* data, std::size_t size) const
+        {
+            switch (m_tolerance.mode)
+            {
+                case tolerance_mode::absolute: return scan<All, tolerance_mode::absolute>(data, size);
+                case tolerance_mode::relative: return scan<All, tolerance_mode::relative>(data, size);
+                case tolerance_mode::ulp: return scan<All, tolerance_mode::ulp>(data, size);
+            }
+            return !All;
+        }
+
+        template <class V, std::enable_if_t<std::is_floating_point_v<V> && std::is_floating_point_v<T>, int> = 0>
+        bool batch_all(const V* data, std::size_t size) const
+        {
+            return scan<true>(data, size);
+        }
+
+        template <class V, std::enable_if_t<std::is_floating_point_v<V> && std::is_floating_point_v<T>, int> = 0>
+        bool batch_any(const V* data, std::size_t size) const
+        {
+            return scan<false>(data, size);
+        }
+
+        template <class V, std::enable_if_t<std::is_floating_point_v<V> && std::is_floating_point_v<T>, int> = 0>
+        static bool batch_items_are(const impl* preds, const V* data, std::size_t size)
+        {
+            return batch_scan<true>(
+                data, size, [&](const V& item) { return preds[std::addressof(item) - data].test(item); });
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            os << "(approx_eq " << item.m_value;
+            if (!(item.m_tolerance == default_tolerance()))
+            {
+                os << " " << item.m_tolerance;
+            }
+            return os << ")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const impl& item)
+        {
+            out = write_value(write_text(out, "(approx_eq "), item.m_value);
+            if (!(item.m_tolerance == default_tolerance()))
+            {
+                out = write_description(write_text(out, " "), item.m_tolerance);
+            }
+            return write_text(out, ")");
+        }
+
+        static tolerance default_tolerance()
+        {
+            return absolute_tolerance(static_cast<double>(std::numeric_limits<T>::epsilon()));
+        }
+    };
+
+    template <class T>
+    auto operator()(T value) const -> impl<T>
+    {
+        return impl<T>{ value, impl<T>::default_tolerance() };
+    }
+
+    template <class T>
+    auto operator()(T value, tolerance tol) const -> impl<T>
+    {
+        return impl<T>{ value, tol };
+    }
+};
+
+constexpr auto modular_inverse(std::uint64_t odd) -> std::uint64_t
+{
+    std::uint64_t result = odd;
+    for (int i = 0; i < 5; ++i)
+    {
+        result *= 2 - odd * result;
+    }
+    return result;
+}
+
+template <class U, class T>
+constexpr auto magnitude(T value) -> U
+{
+    if constexpr (std::is_signed_v<T>)
+    {
+        using signed_t = std::make_signed_t<U>;
+        const auto bits = static_cast<U>(static_cast<signed_t>(value));
+        const auto sign = static_cast<U>(static_cast<signed_t>(value) >> (8 * sizeof(U) - 1));
+        return static_cast<U>((bits ^ sign) - sign);
+    }
+    else
+    {
+        return static_cast<U>(value);
+    }
+}
+
+template <class U>
+struct divisibility_test
+{
+    U m_inverse;
+    U m_limit;
+    unsigned m_shift;
+
+    static auto create(std::uint64_t divisor) -> divisibility_test
+    {
+        if (divisor == 0)
+        {
+            return divisibility_test{ 1, 0, 0 };
+        }
+        unsigned shift = 0;
+        while (((divisor >> shift) & 1) == 0)
+        {
+            ++shift;
+        }
+        return divisibility_test{ static_cast<U>(modular_inverse(divisor >> shift)),
+                                  static_cast<U>(std::numeric_limits<U>::max() / divisor),
+                                  shift };
+    }
+
+    bool operator()(U value) const
+    {
+        static constexpr unsigned bits = 8 * sizeof(U);
+        const U product = value * m_inverse;
+        return static_cast<U>((product >> m_shift) | (product << ((bits - m_shift) & (bits - 1)))) <= m_limit;
+    }
+};
+
+struct is_divisible_by_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 2;
+
+        int m_divisor;
+        divisibility_test<std::uint32_t> m_test32;
+        divisibility_test<std::uint64_t> m_test64;
+
+        template <class T>
+        bool test(T item) const
+        {
+            if constexpr (sizeof(T) <= sizeof(std::uint32_t))
+            {
+                return m_test32(magnitude<std::uint32_t>(item));
+            }
+            else
+            {
+                return m_test64(magnitude<std::uint64_t>(item));
+            }
+        }
+
+        template <class T>
+        bool operator()(T&& item) const
+        {
+            if constexpr (std::is_integral_v<std::decay_t<T>> && sizeof(std::decay_t<T>) <= sizeof(std::uint64_t))
+            {
+                return test(item);
+            }
+            else
+            {
+                return item % m_divisor == 0;
+            }
+        }
+
+        template <class V, std::enable_if_t<std::is_integral_v<V> && sizeof(V) <= sizeof(std::uint64_t), int> = 0>
+        bool batch_all(const V* data, std::size_t size) const
+        {
+            const impl self = *this;
+            return batch_scan<true>(data, size, [self](V item) { return self.test(item); });
+        }
+
+        template <class V, std::enable_if_t<std::is_integral_v<V> && sizeof(V) <= sizeof(std::uint64_t), int> = 0>
+        bool batch_any(const V* data, std::size_t size) const
+        {
+            const impl self = *this;
+            return batch_scan<false>(data, size, [self](V item) { return self.test(item); });
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_divisible_by " << item.m_divisor << ")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const impl& item)
+        {
+            return write_text(write_value(write_text(out, "(is_divisible_by "), item.m_divisor), ")");
+        }
+    };
+
+    auto operator()(int divisor) const -> impl
+    {
+        const auto d = magnitude<std::uint64_t>(divisor);
+        return impl{ divisor, divisibility_test<std::uint32_t>::create(d), divisibility_test<std::uint64_t>::create(d) };
+    }
+};
+
+struct is_even_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        template <class T>
+        bool operator()(T&& item) const
+        {
+            return item % 2 == 0;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_even)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+
+struct is_odd_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        template <class T>
+        bool operator()(T&& item) const
+        {
+            return item % 2 != 0;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_odd)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+
+}  // namespace detail
+
+inline constexpr auto approx_eq = detail::approx_eq_fn{};
+inline constexpr auto is_divisible_by = detail::is_divisible_by_fn{};
+inline constexpr auto is_odd = detail::is_odd_fn{};
+inline constexpr auto is_even = detail::is_even_fn{};
+
+}  // namespace predicates
+}  // namespace ferrugo
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <ferrugo/predicates/containers.hpp>
+#include <ferrugo/predicates/type_erasure.hpp>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+template <class Container>
+class observed_container;
+
+namespace detail
+{
+
+template <class Pred, bool Each>
+struct tracked_items
+{
+    Pred m_pred;
+    std::size_t m_slot;
+
+    template <class Container>
+    bool operator()(const observed_container<Container>& item) const
+    {
+        const std::size_t count = item.tracked_count(m_slot);
+        return Each ? count == item.size() : count > 0;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const tracked_items& item)
+    {
+        return os << (Each ? "(each_item " : "(contains_item ") << ::ferrugo::core::safe_format(item.m_pred) << ")";
+    }
+};
+
+template <class T>
+struct is_insert_result : std::false_type
+{
+};
+
+template <class Iter>
+struct is_insert_result<std::pair<Iter, bool>> : std::true_type
+{
+};
+
+}  // namespace detail
+
+template <class Container>
+class observed_container
+{
+public:
+    using container_type = Container;
+    using value_type = typename Container::value_type;
+    using size_type = typename Container::size_type;
+    using const_iterator = typename Container::const_iterator;
+    using iterator = const_iterator;
+
+    observed_container() = default;
+
+    explicit observed_container(Container container) : m_container{ std::move(container) }
+    {
+    }
+
+    template <class Pred>
+    auto track(const detail::each_item_fn::impl<Pred>& pred) -> detail::tracked_items<Pred, true>
+    {
+        return detail::tracked_items<Pred, true>{ pred.m_pred, add_counter(pred.m_pred) };
+    }
+
+    template <class Pred>
+    auto track(const detail::contains_item_fn::impl<Pred>& pred) -> detail::tracked_items<Pred, false>
+    {
+        return detail::tracked_items<Pred, false>{ pred.m_pred, add_counter(pred.m_pred) };
+    }
+
+    std::size_t tracked_count(std::size_t slot) const
+    {
+        return m_counters[slot].m_count;
+    }
+
+    const Container& container() const
+    {
+        return m_container;
+    }
+
+    const_iterator begin() const
+    {
+        return m_container.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_container.end();
+    }
+
+    size_type size() const
+    {
+        return m_container.size();
+    }
+
+    bool empty() const
+    {
+        return m_container.empty();
+    }
+
+    auto insert(value_type value)
+    {
+        const size_type before = size();
+        return inserted(m_container.insert(std::move(value)), before);
+    }
+
+    const_iterator insert(const_iterator pos, value_type value)
+    {
+        const size_type before = size();
+        return inserted(m_container.insert(pos, std::move(value)), before);
+    }
+
+    const_iterator insert(const_iterator pos, size_type count, const value_type& value)
+    {
+        const size_type before = size();
+        const const_iterator result = m_container.insert(pos, count, value);
+        update_range(result, size() - before);
+        return result;
+    }
+
+    template <class Iter, class = typename std::iterator_traits<Iter>::iterator_category>
+    const_iterator insert(const_iterator pos, Iter first, Iter last)
+    {
+        const size_type before = size();
+        const const_iterator result = m_container.insert(pos, first, last);
+        update_range(result, size() - before);
+        return result;
+    }
+
+    template <class Iter, class = typename std::iterator_traits<Iter>::iterator_category>
+    void insert(Iter first, Iter last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(value_type(*first));
+        }
+    }
+
+    template <class... Args>
+    auto emplace(Args&&... args)
+    {
+        const size_type before = size();
+        return inserted(m_container.emplace(std::forward<Args>(args)...), before);
+    }
+
+    void push_back(value_type value)
+    {
+        m_container.push_back(std::move(value));
+        update(m_container.back(), true);
+    }
+
+    template <class... Args>
+    void emplace_back(Args&&... args)
+    {
+        m_container.emplace_back(std::forward<Args>(args)...);
+        update(m_container.back(), true);
+    }
+
+    void pop_back()
+    {
+        update(m_container.back(), false);
+        m_container.pop_back();
+    }
+
+    const_iterator erase(const_iterator pos)
+    {
+        update(*pos, false);
+        return m_container.erase(pos);
+    }
+
+    const_iterator erase(const_iterator first, const_iterator last)
+    {
+        for (const_iterator it = first; it != last; ++it)
+        {
+            update(*it, false);
+        }
+        return m_container.erase(first, last);
+    }
+
+    template <class Func>
+    void modify(const_iterator pos, Func&& func)
+    {
+        const auto it = m_container.erase(pos, pos);
+        update(*it, false);
+        std::invoke(std::forward<Func>(func), *it);
+        update(*it, true);
+    }
+
+    void clear()
+    {
+        m_container.clear();
+        for (counter& c : m_counters)
+        {
+            c.m_count = 0;
+        }
+    }
+
+private:
+    struct counter
+    {
+        predicate<value_type> m_pred;
+        std::size_t m_count;
+    };
+
+    template <class Pred>
+    std::size_t add_counter(const Pred& pred)
+    {
+        counter c{ [=](const value_type& v) { return detail::invoke_pred(pred, v); }, 0 };
+        for (const value_type& v : m_container)
+        {
+            c.m_count += c.m_pred(v) ? 1 : 0;
+        }
+        m_counters.push_back(std::move(c));
+        return m_counters.size() - 1;
+    }
+
+    void update(const value_type& value, bool added)
+    {
+        for (counter& c : m_counters)
+        {
+            if (c.m_pred(value))
+            {
+                added ? ++c.m_count : --c.m_count;
+            }
+        }
+    }
+
+    void update_range(const_iterator first, size_type count)
+    {
+        for (size_type i = 0; i < count; ++i, ++first)
+        {
+            update(*first, true);
+        }
+    }
+
+    template <class Result>
+    auto inserted(Result result, size_type before)
+    {
+        if constexpr (detail::is_insert_result<Result>{})
+        {
+            if (result.second)
+            {
+                update(*result.first, true);
+            }
+            return std::pair<const_iterator, bool>{ result.first, result.second };
+        }
+        else
+        {
+            if (size() != before)
+            {
+                update(*result, true);
+            }
+            return const_iterator{ result };
+        }
+    }
+
+    Container m_container;
+    std::vector<counter> m_counters;
+};
+
+}  // namespace predicates
+}  // namespace ferrugo
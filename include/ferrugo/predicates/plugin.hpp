@@ -0,0 +1,117 @@
+#pragma once
+
+#include <dlfcn.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ferrugo/core/types.hpp>
+#include <ferrugo/predicates/codegen.hpp>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+struct plugin_error : std::runtime_error
+{
+    explicit plugin_error(std::string msg) : std::runtime_error(std::move(msg))
+    {
+    }
+};
+
+template <class T>
+class plugin_predicate
+{
+public:
+    using function_type = bool (*)(const void*) noexcept;
+
+    explicit plugin_predicate(const std::string& path, const std::string& function_name = "ferrugo_predicate")
+        : m_path{ path }
+        , m_handle{ ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL) }
+    {
+        if (!m_handle)
+        {
+            throw plugin_error{ "cannot load " + path + ": " + ::dlerror() };
+        }
+        try
+        {
+            m_func = reinterpret_cast<function_type>(symbol(function_name));
+            const auto abi_version = reinterpret_cast<abi_version_type>(symbol(function_name + "_abi_version"));
+            const auto record_size = reinterpret_cast<record_size_type>(symbol(function_name + "_record_size"));
+            if (abi_version() != plugin_abi_version)
+            {
+                throw plugin_error{ path + " was generated for plugin ABI version " + std::to_string(abi_version()) };
+            }
+            if (record_size() != sizeof(T))
+            {
+                throw plugin_error{ path + " was generated for a record of " + std::to_string(record_size()) + " bytes" };
+            }
+        }
+        catch (...)
+        {
+            ::dlclose(m_handle);
+            throw;
+        }
+    }
+
+    plugin_predicate(const plugin_predicate&) = delete;
+    plugin_predicate& operator=(const plugin_predicate&) = delete;
+
+    plugin_predicate(plugin_predicate&& other) noexcept
+        : m_path{ std::move(other.m_path) }
+        , m_handle{ std::exchange(other.m_handle, nullptr) }
+        , m_func{ std::exchange(other.m_func, nullptr) }
+    {
+    }
+
+    plugin_predicate& operator=(plugin_predicate&& other) noexcept
+    {
+        std::swap(m_path, other.m_path);
+        std::swap(m_handle, other.m_handle);
+        std::swap(m_func, other.m_func);
+        return *this;
+    }
+
+    ~plugin_predicate()
+    {
+        if (m_handle)
+        {
+            ::dlclose(m_handle);
+        }
+    }
+
+    bool operator()(::ferrugo::core::in_t<T> item) const
+    {
+        return m_func(&item);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const plugin_predicate& item)
+    {
+        return os << "(plugin " << item.m_path << ")";
+    }
+
+private:
+    using abi_version_type = std::uint32_t (*)() noexcept;
+    using record_size_type = std::size_t (*)() noexcept;
+
+    void* symbol(const std::string& name) const
+    {
+        void* result = ::dlsym(m_handle, name.c_str());
+        if (!result)
+        {
+            throw plugin_error{ "cannot find " + name + " in " + m_path };
+        }
+        return result;
+    }
+
+    std::string m_path;
+    void* m_handle;
+    function_type m_func = nullptr;
+};
+
+}  // namespace predicates
+}  // namespace ferrugo
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ferrugo/predicates/core.hpp>
+#include <ferrugo/predicates/description.hpp>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+struct prefilter_options
+{
+    double false_positive_rate = 0.01;
+    bool collect_stats = false;
+};
+
+struct prefilter_stats
+{
+    std::uint64_t probes = 0;
+    std::uint64_t rejected = 0;
+    std::uint64_t false_positives = 0;
+
+    double rejection_rate() const
+    {
+        return probes != 0 ? static_cast<double>(rejected) / static_cast<double>(probes) : 0.0;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const prefilter_stats& item)
+    {
+        return os << "(prefilter_stats probes=" << item.probes << " rejected=" << item.rejected
+                  << " false_positives=" << item.false_positives << ")";
+    }
+};
+
+namespace detail
+{
+
+constexpr std::uint64_t rotate_left(std::uint64_t value, int shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
+
+constexpr std::uint64_t mix_hash(std::uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+inline std::uint64_t hash_bytes(std::string_view bytes)
+{
+    constexpr std::uint64_t k0 = 0x9E3779B97F4A7C15ull;
+    constexpr std::uint64_t k1 = 0x87C37B91114253D5ull;
+    std::uint64_t h = k0 ^ bytes.size();
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes.data() + i, sizeof(word));
+        h = rotate_left(h ^ (word * k1), 31) * k0;
+    }
+    if (i != bytes.size())
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+        h = rotate_left(h ^ (word * k1), 31) * k0;
+    }
+    return mix_hash(h);
+}
+
+class block_bloom_filter
+{
+public:
+    static constexpr std::size_t block_bits = 256;
+
+    block_bloom_filter(std::size_t key_count, double false_positive_rate)
+    {
+        const double rate = std::clamp(false_positive_rate, 1e-9, 0.5);
+        const double bits_per_key = std::ceil(-1.7 * std::log2(rate));
+        const auto bits = static_cast<std::size_t>(static_cast<double>(std::max<std::size_t>(key_count, 1)) * bits_per_key);
+        m_blocks.resize(std::max<std::size_t>((bits + block_bits - 1) / block_bits, 1));
+    }
+
+    void insert(std::uint64_t hash)
+    {
+        block& b = m_blocks[block_index(hash)];
+        const auto key = static_cast<std::uint32_t>(hash);
+        for (std::size_t i = 0; i < lanes; ++i)
+        {
+            b.m_words[i] |= std::uint32_t{ 1 } << ((key * salts[i]) >> 27);
+        }
+    }
+
+    bool may_contain(std::uint64_t hash) const
+    {
+        const block& b = m_blocks[block_index(hash)];
+        const auto key = static_cast<std::uint32_t>(hash);
+        std::uint32_t missing = 0;
+        for (std::size_t i = 0; i < lanes; ++i)
+        {
+            missing |= ~b.m_words[i] & (std::uint32_t{ 1 } << ((key * salts[i]) >> 27));
+        }
+        return missing == 0;
+    }
+
+    std::size_t size_bytes() const
+    {
+        return m_blocks.size() * sizeof(block);
+    }
+
+private:
+    static constexpr std::size_t lanes = 8;
+    static constexpr std::uint32_t salts[lanes]
+        = { 0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du, 0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u };
+
+    struct alignas(32) block
+    {
+        std::uint32_t m_words[lanes] = {};
+    };
+
+    std::size_t block_index(std::uint64_t hash) const
+    {
+        return static_cast<std::size_t>(((hash >> 32) * m_blocks.size()) >> 32);
+    }
+
+    std::vector<block> m_blocks;
+};
+
+template <class Key>
+using prefilter_key_t = std::conditional_t<std::is_convertible_v<const Key&, std::string_view>, std::string, Key>;
+
+template <class Key>
+class prefiltered_set
+{
+    static_assert(
+        std::is_same_v<Key, std::string> || std::is_integral_v<Key> || std::is_enum_v<Key>,
+        "is_in_prefiltered requires integral, enum or string keys");
+
+public:
+    template <class Iter>
+    prefiltered_set(Iter first, Iter last, const prefilter_options& options)
+        : m_filter{ static_cast<std::size_t>(std::distance(first, last)), options.false_positive_rate }
+        , m_collect_stats{ options.collect_stats }
+    {
+        const auto count = static_cast<std::size_t>(std::distance(first, last));
+        std::size_t capacity = 16;
+        while (capacity < 2 * count)
+        {
+            capacity *= 2;
+        }
+        m_slots.assign(capacity, 0);
+        m_keys.reserve(count);
+        m_hashes.reserve(count);
+        for (; first != last; ++first)
+        {
+            add(Key(*first));
+        }
+    }
+
+    template <class U>
+    bool contains(const U& item) const
+    {
+        const std::optional<lookup_t> key = to_lookup(item);
+        const std::uint64_t hash = key ? hash_of(*key) : 0;
+        const bool pass = key && m_filter.may_contain(hash);
+        const bool found = pass && find(*key, hash);
+        if (m_collect_stats)
+        {
+            m_stats.m_probes.fetch_add(1, std::memory_order_relaxed);
+            if (!pass)
+            {
+                m_stats.m_rejected.fetch_add(1, std::memory_order_relaxed);
+            }
+            else if (!found)
+            {
+                m_stats.m_false_positives.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return found;
+    }
+
+    std::size_t size() const
+    {
+        return m_keys.size();
+    }
+
+    std::size_t filter_bytes() const
+    {
+        return m_filter.size_bytes();
+    }
+
+    prefilter_stats stats() const
+    {
+        return prefilter_stats{ m_stats.m_probes.load(std::memory_order_relaxed),
+                                m_stats.m_rejected.load(std::memory_order_relaxed),
+                                m_stats.m_false_positives.load(std::memory_order_relaxed) };
+    }
+
+private:
+    using lookup_t = std::conditional_t<std::is_same_v<Key, std::string>, std::string_view, Key>;
+
+    struct alignas(64) counters
+    {
+        std::atomic<std::uint64_t> m_probes{ 0 };
+        std::atomic<std::uint64_t> m_rejected{ 0 };
+        std::atomic<std::uint64_t> m_false_positives{ 0 };
+    };
+
+    template <class U>
+    static std::optional<lookup_t> to_lookup(const U& item)
+    {
+        if constexpr (std::is_same_v<lookup_t, std::string_view>)
+        {
+            static_assert(std::is_convertible_v<const U&, std::string_view>, "string keys require string lookups");
+            return std::string_view{ item };
+        }
+        else if constexpr (std::is_same_v<U, Key>)
+        {
+            return item;
+        }
+        else
+        {
+            static_assert(
+                std::is_integral_v<Key> && std::is_integral_v<U>, "lookups must have the key type or be integral");
+            const auto key = static_cast<Key>(item);
+            if (static_cast<U>(key) != item || (key < Key{}) != (item < U{}))
+            {
+                return std::nullopt;
+            }
+            return key;
+        }
+    }
+
+    static std::uint64_t hash_of(const lookup_t& key)
+    {
+        if constexpr (std::is_same_v<lookup_t, std::string_view>)
+        {
+            return hash_bytes(key);
+        }
+        else
+        {
+            return mix_hash(static_cast<std::uint64_t>(key));
+        }
+    }
+
+    bool find(const lookup_t& key, std::uint64_t hash) const
+    {
+        const std::size_t mask = m_slots.size() - 1;
+        for (std::size_t slot = static_cast<std::size_t>(hash) & mask;; slot = (slot + 1) & mask)
+        {
+            const std::uint32_t index = m_slots[slot];
+            if (index == 0)
+            {
+                return false;
+            }
+            if (m_hashes[index - 1] == hash && lookup_t(m_keys[index - 1]) == key)
+            {
+                return true;
+            }
+        }
+    }
+
+    void add(Key key)
+    {
+        const std::uint64_t hash = hash_of(lookup_t(key));
+        if (find(lookup_t(key), hash))
+        {
+            return;
+        }
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t slot = static_cast<std::size_t>(hash) & mask;
+        while (m_slots[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        m_keys.push_back(std::move(key));
+        m_hashes.push_back(hash);
+        m_slots[slot] = static_cast<std::uint32_t>(m_keys.size());
+        m_filter.insert(hash);
+    }
+
+    block_bloom_filter m_filter;
+    std::vector<std::uint32_t> m_slots;
+    std::vector<Key> m_keys;
+    std::vector<std::uint64_t> m_hashes;
+    bool m_collect_stats;
+    mutable counters m_stats;
+};
+
+struct is_in_prefiltered_fn
+{
+    template <class Key>
+    struct impl
+    {
+        static constexpr std::size_t cost = 8;
+
+        std::shared_ptr<const prefiltered_set<Key>> m_set;
+
+        template <class U>
+        bool operator()(const U& item) const
+        {
+            return m_set->contains(item);
+        }
+
+        prefilter_stats stats() const
+        {
+            return m_set->stats();
+        }
+
+        std::size_t filter_bytes() const
+        {
+            return m_set->filter_bytes();
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_in_prefiltered " << item.m_set->size() << ")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const impl& item)
+        {
+            return write_text(write_value(write_text(out, "(is_in_prefiltered "), item.m_set->size()), ")");
+        }
+    };
+
+    template <class Range>
+    auto operator()(const Range& keys, const prefilter_options& options = {}) const
+        -> impl<prefilter_key_t<std::decay_t<decltype(*std::begin(keys))>>>
+    {
+        using key_t = prefilter_key_t<std::decay_t<decltype(*std::begin(keys))>>;
+        return impl<key_t>{ std::make_shared<const prefiltered_set<key_t>>(std::begin(keys), std::end(keys), options) };
+    }
+
+    template <class T>
+    auto operator()(std::initializer_list<T> keys, const prefilter_options& options = {}) const
+        -> impl<prefilter_key_t<T>>
+    {
+        return impl<prefilter_key_t<T>>{ std::make_shared<const prefiltered_set<prefilter_key_t<T>>>(
+            keys.begin(), keys.end(), options) };
+    }
+};
+
+}  // namespace detail
+
+inline constexpr auto is_in_prefiltered = detail::is_in_prefiltered_fn{};
+
+}  // namespace predicates
+}  // namespace ferrugo
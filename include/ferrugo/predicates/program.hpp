@@ -0,0 +1,1072 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <ferrugo/predicates/core.hpp>
+#include <ferrugo/predicates/mapped_file.hpp>
+#include <ferrugo/predicates/strings.hpp>
+#include <fstream>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+struct program_error : std::runtime_error
+{
+    explicit program_error(std::string msg) : std::runtime_error(std::move(msg))
+    {
+    }
+};
+
+enum class opcode : std::uint8_t
+{
+    all,
+    any,
+    negate,
+    field,
+    compare,
+    string_is,
+    string_starts_with,
+    string_ends_with,
+    string_contains,
+    is_in
+};
+
+enum class comparison : std::uint8_t
+{
+    eq,
+    ne,
+    lt,
+    gt,
+    le,
+    ge
+};
+
+inline std::ostream& operator<<(std::ostream& os, const comparison item)
+{
+    switch (item)
+    {
+        case comparison::eq: return os << "eq";
+        case comparison::ne: return os << "ne";
+        case comparison::lt: return os << "lt";
+        case comparison::gt: return os << "gt";
+        case comparison::le: return os << "le";
+        case comparison::ge: return os << "ge";
+    }
+    return os;
+}
+
+class program_value
+{
+public:
+    enum class kind : std::uint8_t
+    {
+        integer,
+        real,
+        string,
+        record,
+        missing
+    };
+
+    using field_accessor = program_value (*)(const void*, std::uint32_t);
+
+    program_value() : m_kind{ kind::missing }
+    {
+    }
+
+    template <class T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    program_value(T value) : m_kind{ kind::integer }, m_integer{ static_cast<std::int64_t>(value) }
+    {
+    }
+
+    template <class T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    program_value(T value) : m_kind{ kind::real }, m_real{ static_cast<double>(value) }
+    {
+    }
+
+    program_value(std::string_view value) : m_kind{ kind::string }, m_string{ value }
+    {
+    }
+
+    program_value(const char* value) : program_value(std::string_view{ value })
+    {
+    }
+
+    program_value(const std::string& value) : program_value(std::string_view{ value })
+    {
+    }
+
+    template <class... Ts>
+    program_value(const std::tuple<Ts...>& value) : program_value(&value, &tuple_field<Ts...>)
+    {
+    }
+
+    program_value(const void* record, field_accessor accessor) : m_kind{ kind::record }, m_record{ record }, m_accessor{ accessor }
+    {
+    }
+
+    kind get_kind() const
+    {
+        return m_kind;
+    }
+
+    std::int64_t integer() const
+    {
+        return m_integer;
+    }
+
+    double real() const
+    {
+        return m_real;
+    }
+
+    std::string_view string() const
+    {
+        return m_string;
+    }
+
+    program_value field(std::uint32_t index) const
+    {
+        return m_accessor(m_record, index);
+    }
+
+private:
+    template <class... Ts>
+    static program_value tuple_field(const void* record, std::uint32_t index)
+    {
+        return tuple_field_at<0, Ts...>(*static_cast<const std::tuple<Ts...>*>(record), index);
+    }
+
+    template <std::size_t I, class... Ts>
+    static program_value tuple_field_at(const std::tuple<Ts...>& record, std::uint32_t index)
+    {
+        if constexpr (I == sizeof...(Ts))
+        {
+            return program_value{};
+        }
+        else
+        {
+            return index == I ? program_value(std::get<I>(record)) : tuple_field_at<I + 1, Ts...>(record, index);
+        }
+    }
+
+    kind m_kind;
+    std::int64_t m_integer = 0;
+    double m_real = 0.0;
+    std::string_view m_string;
+    const void* m_record = nullptr;
+    field_accessor m_accessor = nullptr;
+};
+
+namespace detail
+{
+
+static constexpr inline char program_magic[8] = { 'F', 'R', 'G', 'P', 'R', 'E', 'D', '\0' };
+static constexpr inline std::uint32_t program_format_version = 1;
+static constexpr inline std::uint32_t program_byte_order = 0x01020304;
+static constexpr inline std::uint32_t program_max_depth = 256;
+
+struct program_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t node_count;
+    std::uint32_t reserved;
+    std::uint64_t nodes_offset;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+};
+
+struct program_node
+{
+    opcode op;
+    std::uint8_t flags;
+    program_value::kind kind;
+    std::uint8_t reserved;
+    std::uint32_t a;
+    std::uint32_t b;
+    std::uint32_t size;
+};
+
+static_assert(sizeof(program_header) == 48);
+static_assert(sizeof(program_node) == 16);
+
+struct string_entry
+{
+    std::uint32_t offset;
+    std::uint32_t size;
+};
+
+template <class T>
+struct is_negate : std::false_type
+{
+};
+
+template <class Pred>
+struct is_negate<negate_fn::impl<Pred>> : std::true_type
+{
+};
+
+template <class T>
+static constexpr inline bool is_program_constant
+    = std::is_arithmetic_v<T> || std::is_convertible_v<const T&, std::string_view> || std::is_same_v<std::decay_t<T>, const char*>;
+
+template <class Op>
+constexpr comparison comparison_of()
+{
+    if constexpr (std::is_same_v<Op, std::equal_to<>>)
+    {
+        return comparison::eq;
+    }
+    else if constexpr (std::is_same_v<Op, std::not_equal_to<>>)
+    {
+        return comparison::ne;
+    }
+    else if constexpr (std::is_same_v<Op, std::less<>>)
+    {
+        return comparison::lt;
+    }
+    else if constexpr (std::is_same_v<Op, std::greater<>>)
+    {
+        return comparison::gt;
+    }
+    else if constexpr (std::is_same_v<Op, std::less_equal<>>)
+    {
+        return comparison::le;
+    }
+    else
+    {
+        static_assert(std::is_same_v<Op, std::greater_equal<>>, "unsupported comparison");
+        return comparison::ge;
+    }
+}
+
+template <class Pred>
+using string_test_of = typename Pred::string_test_type;
+
+template <class Test>
+constexpr opcode string_opcode()
+{
+    if constexpr (std::is_same_v<Test, string_is_fn>)
+    {
+        return opcode::string_is;
+    }
+    else if constexpr (std::is_same_v<Test, string_starts_with_fn>)
+    {
+        return opcode::string_starts_with;
+    }
+    else if constexpr (std::is_same_v<Test, string_ends_with_fn>)
+    {
+        return opcode::string_ends_with;
+    }
+    else
+    {
+        static_assert(std::is_same_v<Test, string_contains_fn>, "unsupported string test");
+        return opcode::string_contains;
+    }
+}
+
+template <class L, class R>
+bool compare_values(comparison cmp, const L& lhs, const R& rhs)
+{
+    switch (cmp)
+    {
+        case comparison::eq: return lhs == rhs;
+        case comparison::ne: return lhs != rhs;
+        case comparison::lt: return lhs < rhs;
+        case comparison::gt: return lhs > rhs;
+        case comparison::le: return lhs <= rhs;
+        case comparison::ge: return lhs >= rhs;
+    }
+    return false;
+}
+
+inline char fold_case(char ch, bool case_insensitive)
+{
+    return case_insensitive ? static_cast<char>(std::tolower(static_cast<unsigned char>(ch))) : ch;
+}
+
+inline std::size_t align_to(std::size_t offset, std::size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace detail
+
+class program_view
+{
+public:
+    program_view(const void* data, std::size_t size) : m_data{ static_cast<const std::byte*>(data) }, m_size{ size }
+    {
+        if (m_size < sizeof(detail::program_header))
+        {
+            throw program_error{ "program is truncated" };
+        }
+        std::memcpy(&m_header, m_data, sizeof(m_header));
+        if (std::memcmp(m_header.magic, detail::program_magic, sizeof(m_header.magic)) != 0)
+        {
+            throw program_error{ "not a predicate program" };
+        }
+        if (m_header.version != detail::program_format_version)
+        {
+            throw program_error{ "unsupported program version " + std::to_string(m_header.version) };
+        }
+        if (m_header.byte_order != detail::program_byte_order)
+        {
+            throw program_error{ "program byte order does not match the host" };
+        }
+        if (m_header.node_count == 0 || !fits(m_header.nodes_offset, m_header.node_count, sizeof(detail::program_node))
+            || !fits(m_header.data_offset, m_header.data_size, 1)
+            || m_header.nodes_offset % alignof(detail::program_node) != 0
+            || m_header.data_offset % alignof(std::int64_t) != 0)
+        {
+            throw program_error{ "program layout is out of bounds" };
+        }
+        if (validate(0, 1) != m_header.node_count)
+        {
+            throw program_error{ "program has trailing nodes" };
+        }
+    }
+
+    bool operator()(const program_value& item) const
+    {
+        return evaluate(0, item);
+    }
+
+    std::size_t node_count() const
+    {
+        return m_header.node_count;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    const std::byte* data() const
+    {
+        return m_data;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const program_view& item)
+    {
+        item.format(os, 0);
+        return os;
+    }
+
+    detail::program_node node_at(std::uint32_t index) const
+    {
+        detail::program_node result;
+        std::memcpy(&result, m_data + m_header.nodes_offset + index * sizeof(detail::program_node), sizeof(result));
+        return result;
+    }
+
+    std::string_view string_at(std::uint32_t offset, std::uint32_t size) const
+    {
+        return std::string_view{ reinterpret_cast<const char*>(pool() + offset), size };
+    }
+
+    std::int64_t integer_at(std::uint32_t offset) const
+    {
+        std::int64_t result;
+        std::memcpy(&result, pool() + offset, sizeof(result));
+        return result;
+    }
+
+    double real_at(std::uint32_t offset) const
+    {
+        double result;
+        std::memcpy(&result, pool() + offset, sizeof(result));
+        return result;
+    }
+
+    detail::string_entry string_entry_at(std::uint32_t offset, std::uint32_t index) const
+    {
+        detail::string_entry result;
+        std::memcpy(&result, pool() + offset + index * sizeof(detail::string_entry), sizeof(result));
+        return result;
+    }
+
+private:
+    const std::byte* pool() const
+    {
+        return m_data + m_header.data_offset;
+    }
+
+    bool fits(std::uint64_t offset, std::uint64_t count, std::uint64_t element_size) const
+    {
+        return offset <= m_size && count <= (m_size - offset) / element_size;
+    }
+
+    void require_data(std::uint64_t offset, std::uint64_t size) const
+    {
+        if (offset > m_header.data_size || size > m_header.data_size - offset)
+        {
+            throw program_error{ "program constant is out of bounds" };
+        }
+    }
+
+    std::uint32_t validate(std::uint32_t index, std::uint32_t depth) const
+    {
+        if (index >= m_header.node_count)
+        {
+            throw program_error{ "program node is out of bounds" };
+        }
+        if (depth > detail::program_max_depth)
+        {
+            throw program_error{ "program is nested too deeply" };
+        }
+        const detail::program_node n = node_at(index);
+        if (n.size == 0 || index + std::uint64_t(n.size) > m_header.node_count)
+        {
+            throw program_error{ "program node has invalid size" };
+        }
+        std::uint32_t children = 0;
+        std::uint32_t child = index + 1;
+        while (child < index + n.size)
+        {
+            const std::uint32_t child_size = validate(child, depth + 1);
+            if (child_size > index + n.size - child)
+            {
+                throw program_error{ "program node has invalid size" };
+            }
+            child += child_size;
+            ++children;
+        }
+        if (child != index + n.size)
+        {
+            throw program_error{ "program node has invalid size" };
+        }
+        switch (n.op)
+        {
+            case opcode::all:
+            case opcode::any:
+                if (children != n.b)
+                {
+                    throw program_error{ "program node has invalid child count" };
+                }
+                break;
+            case opcode::negate:
+            case opcode::field:
+                if (children != 1)
+                {
+                    throw program_error{ "program node has invalid child count" };
+                }
+                break;
+            case opcode::compare:
+                require_data(n.a, n.kind == program_value::kind::string ? n.b : sizeof(std::int64_t));
+                if (n.flags > static_cast<std::uint8_t>(comparison::ge) || n.kind >= program_value::kind::record)
+                {
+                    throw program_error{ "program node has invalid comparison" };
+                }
+                break;
+            case opcode::string_contains: require_data(detail::align_to(std::uint64_t(n.a) + n.b, 4), 256); [[fallthrough]];
+            case opcode::string_is:
+            case opcode::string_starts_with:
+            case opcode::string_ends_with: require_data(n.a, n.b); break;
+            case opcode::is_in:
+                if (n.kind == program_value::kind::string)
+                {
+                    require_data(n.a, std::uint64_t(n.b) * sizeof(detail::string_entry));
+                    for (std::uint32_t i = 0; i < n.b; ++i)
+                    {
+                        const detail::string_entry entry = string_entry_at(n.a, i);
+                        require_data(entry.offset, entry.size);
+                    }
+                }
+                else
+                {
+                    require_data(n.a, std::uint64_t(n.b) * sizeof(std::int64_t));
+                }
+                break;
+            default: throw program_error{ "program node has unknown opcode" };
+        }
+        if (n.op != opcode::all && n.op != opcode::any && n.op != opcode::negate && n.op != opcode::field && children != 0)
+        {
+            throw program_error{ "program leaf node has children" };
+        }
+        return n.size;
+    }
+
+    bool evaluate(std::uint32_t index, const program_value& item) const
+    {
+        const detail::program_node n = node_at(index);
+        switch (n.op)
+        {
+            case opcode::all:
+            {
+                std::uint32_t child = index + 1;
+                for (std::uint32_t i = 0; i < n.b; ++i)
+                {
+                    if (!evaluate(child, item))
+                    {
+                        return false;
+                    }
+                    child += node_at(child).size;
+                }
+                return true;
+            }
+            case opcode::any:
+            {
+                std::uint32_t child = index + 1;
+                for (std::uint32_t i = 0; i < n.b; ++i)
+                {
+                    if (evaluate(child, item))
+                    {
+                        return true;
+                    }
+                    child += node_at(child).size;
+                }
+                return false;
+            }
+            case opcode::negate: return !evaluate(index + 1, item);
+            case opcode::field:
+                return item.get_kind() == program_value::kind::record && evaluate(index + 1, item.field(n.a));
+            case opcode::compare: return compare(n, item);
+            case opcode::string_is:
+            case opcode::string_starts_with:
+            case opcode::string_ends_with:
+            case opcode::string_contains:
+                return item.get_kind() == program_value::kind::string && test_string(n, item.string());
+            case opcode::is_in: return is_in(n, item);
+        }
+        return false;
+    }
+
+    bool compare(const detail::program_node& n, const program_value& item) const
+    {
+        const auto cmp = static_cast<comparison>(n.flags);
+        switch (n.kind)
+        {
+            case program_value::kind::integer:
+                switch (item.get_kind())
+                {
+                    case program_value::kind::integer: return detail::compare_values(cmp, item.integer(), integer_at(n.a));
+                    case program_value::kind::real:
+                        return detail::compare_values(cmp, item.real(), static_cast<double>(integer_at(n.a)));
+                    default: return false;
+                }
+            case program_value::kind::real:
+                switch (item.get_kind())
+                {
+                    case program_value::kind::integer:
+                        return detail::compare_values(cmp, static_cast<double>(item.integer()), real_at(n.a));
+                    case program_value::kind::real: return detail::compare_values(cmp, item.real(), real_at(n.a));
+                    default: return false;
+                }
+            case program_value::kind::string:
+                return item.get_kind() == program_value::kind::string
+                       && detail::compare_values(cmp, item.string(), string_at(n.a, n.b));
+            default: return false;
+        }
+    }
+
+    bool test_string(const detail::program_node& n, std::string_view actual) const
+    {
+        const std::string_view expected = string_at(n.a, n.b);
+        const bool case_insensitive = n.flags != 0;
+        const auto equal
+            = [&](const char* lhs, const char* rhs, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (detail::fold_case(lhs[i], case_insensitive) != rhs[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+        switch (n.op)
+        {
+            case opcode::string_is: return actual.size() == expected.size() && equal(actual.data(), expected.data(), expected.size());
+            case opcode::string_starts_with:
+                return actual.size() >= expected.size() && equal(actual.data(), expected.data(), expected.size());
+            case opcode::string_ends_with:
+                return actual.size() >= expected.size()
+                       && equal(actual.data() + actual.size() - expected.size(), expected.data(), expected.size());
+            case opcode::string_contains:
+            {
+                const std::size_t m = expected.size();
+                if (m == 0)
+                {
+                    return true;
+                }
+                const auto* skip
+                    = reinterpret_cast<const std::uint8_t*>(pool() + detail::align_to(std::uint64_t(n.a) + n.b, 4));
+                for (std::size_t pos = 0; pos + m <= actual.size();)
+                {
+                    const char last = detail::fold_case(actual[pos + m - 1], case_insensitive);
+                    if (last == expected[m - 1] && equal(actual.data() + pos, expected.data(), m - 1))
+                    {
+                        return true;
+                    }
+                    pos += skip[static_cast<unsigned char>(last)];
+                }
+                return false;
+            }
+            default: return false;
+        }
+    }
+
+    bool is_in(const detail::program_node& n, const program_value& item) const
+    {
+        if (n.kind == program_value::kind::string)
+        {
+            if (item.get_kind() != program_value::kind::string)
+            {
+                return false;
+            }
+            std::uint32_t lo = 0;
+            std::uint32_t hi = n.b;
+            while (lo < hi)
+            {
+                const std::uint32_t mid = lo + (hi - lo) / 2;
+                const detail::string_entry entry = string_entry_at(n.a, mid);
+                const int c = string_at(entry.offset, entry.size).compare(item.string());
+                if (c == 0)
+                {
+                    return true;
+                }
+                (c < 0 ? lo = mid + 1 : hi = mid);
+            }
+            return false;
+        }
+        if (item.get_kind() != program_value::kind::integer)
+        {
+            return false;
+        }
+        std::uint32_t lo = 0;
+        std::uint32_t hi = n.b;
+        while (lo < hi)
+        {
+            const std::uint32_t mid = lo + (hi - lo) / 2;
+            const std::int64_t v = integer_at(n.a + mid * sizeof(std::int64_t));
+            if (v == item.integer())
+            {
+                return true;
+            }
+            (v < item.integer() ? lo = mid + 1 : hi = mid);
+        }
+        return false;
+    }
+
+    void format(std::ostream& os, std::uint32_t index) const
+    {
+        const detail::program_node n = node_at(index);
+        const auto format_children = [&]()
+        {
+            std::uint32_t child = index + 1;
+            while (child < index + n.size)
+            {
+                os << " ";
+                format(os, child);
+                child += node_at(child).size;
+            }
+            os << ")";
+        };
+        const auto format_string = [&](const char* name)
+        {
+            os << "(" << name << " " << (n.flags != 0 ? string_comparison::case_insensitive : string_comparison::case_sensitive)
+               << " \"" << string_at(n.a, n.b) << "\")";
+        };
+        switch (n.op)
+        {
+            case opcode::all: os << "(all"; return format_children();
+            case opcode::any: os << "(any"; return format_children();
+            case opcode::negate: os << "(not"; return format_children();
+            case opcode::field: os << "(element " << n.a; return format_children();
+            case opcode::compare:
+                os << "(" << static_cast<comparison>(n.flags) << " ";
+                switch (n.kind)
+                {
+                    case program_value::kind::integer: os << integer_at(n.a); break;
+                    case program_value::kind::real: os << real_at(n.a); break;
+                    default: os << string_at(n.a, n.b); break;
+                }
+                os << ")";
+                return;
+            case opcode::string_is: return format_string("string_is");
+            case opcode::string_starts_with: return format_string("string_starts_with");
+            case opcode::string_ends_with: return format_string("string_ends_with");
+            case opcode::string_contains: return format_string("string_contains");
+            case opcode::is_in:
+                os << "(is_in";
+                for (std::uint32_t i = 0; i < n.b; ++i)
+                {
+                    if (n.kind == program_value::kind::string)
+                    {
+                        const detail::string_entry entry = string_entry_at(n.a, i);
+                        os << " " << string_at(entry.offset, entry.size);
+                    }
+                    else
+                    {
+                        os << " " << integer_at(n.a + i * sizeof(std::int64_t));
+                    }
+                }
+                os << ")";
+                return;
+        }
+    }
+
+    const std::byte* m_data;
+    std::size_t m_size;
+    detail::program_header m_header;
+};
+
+class program_builder
+{
+public:
+    program_builder& begin_all()
+    {
+        return open(opcode::all, 0);
+    }
+
+    program_builder& begin_any()
+    {
+        return open(opcode::any, 0);
+    }
+
+    program_builder& begin_negate()
+    {
+        return open(opcode::negate, 0);
+    }
+
+    program_builder& begin_field(std::uint32_t index)
+    {
+        return open(opcode::field, index);
+    }
+
+    program_builder& end()
+    {
+        if (m_open.empty())
+        {
+            throw program_error{ "end() without a matching begin" };
+        }
+        const open_node top = m_open.back();
+        m_open.pop_back();
+        detail::program_node& n = m_nodes[top.index];
+        n.size = static_cast<std::uint32_t>(m_nodes.size() - top.index);
+        if ((n.op == opcode::negate || n.op == opcode::field) && top.children != 1)
+        {
+            throw program_error{ "negate and field require exactly one child" };
+        }
+        if (n.op == opcode::all || n.op == opcode::any)
+        {
+            n.b = top.children;
+        }
+        return *this;
+    }
+
+    program_builder& compare(comparison cmp, const program_value& constant)
+    {
+        detail::program_node n = make_node(opcode::compare);
+        n.flags = static_cast<std::uint8_t>(cmp);
+        n.kind = constant.get_kind();
+        switch (constant.get_kind())
+        {
+            case program_value::kind::integer: n.a = add_data(constant.integer()); break;
+            case program_value::kind::real: n.a = add_data(constant.real()); break;
+            case program_value::kind::string:
+                n.a = add_string(constant.string());
+                n.b = static_cast<std::uint32_t>(constant.string().size());
+                break;
+            default: throw program_error{ "records cannot be used as constants" };
+        }
+        return add_leaf(n);
+    }
+
+    program_builder& string_test(opcode op, std::string_view expected, string_comparison comparison)
+    {
+        if (op != opcode::string_is && op != opcode::string_starts_with && op != opcode::string_ends_with
+            && op != opcode::string_contains)
+        {
+            throw program_error{ "not a string opcode" };
+        }
+        const bool case_insensitive = comparison == string_comparison::case_insensitive;
+        std::string folded{ expected };
+        std::transform(
+            folded.begin(), folded.end(), folded.begin(), [&](char ch) { return detail::fold_case(ch, case_insensitive); });
+
+        detail::program_node n = make_node(op);
+        n.flags = case_insensitive ? 1 : 0;
+        n.a = add_string(folded);
+        n.b = static_cast<std::uint32_t>(folded.size());
+        if (op == opcode::string_contains)
+        {
+            std::uint8_t skip[256];
+            const std::size_t m = folded.size();
+            std::fill(std::begin(skip), std::end(skip), static_cast<std::uint8_t>(std::clamp<std::size_t>(m, 1, 255)));
+            for (std::size_t i = 0; i + 1 < m; ++i)
+            {
+                skip[static_cast<unsigned char>(folded[i])] = static_cast<std::uint8_t>(std::min<std::size_t>(m - 1 - i, 255));
+            }
+            m_data.resize(detail::align_to(m_data.size(), 4));
+            append_bytes(skip, sizeof(skip));
+        }
+        return add_leaf(n);
+    }
+
+    program_builder& is_in(std::vector<std::int64_t> values)
+    {
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        detail::program_node n = make_node(opcode::is_in);
+        n.kind = program_value::kind::integer;
+        m_data.resize(detail::align_to(m_data.size(), alignof(std::int64_t)));
+        n.a = static_cast<std::uint32_t>(m_data.size());
+        n.b = static_cast<std::uint32_t>(values.size());
+        append_bytes(values.data(), values.size() * sizeof(std::int64_t));
+        return add_leaf(n);
+    }
+
+    program_builder& is_in(std::vector<std::string_view> values)
+    {
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        std::vector<detail::string_entry> entries;
+        for (std::string_view value : values)
+        {
+            entries.push_back(detail::string_entry{ add_string(value), static_cast<std::uint32_t>(value.size()) });
+        }
+        detail::program_node n = make_node(opcode::is_in);
+        n.kind = program_value::kind::string;
+        m_data.resize(detail::align_to(m_data.size(), alignof(detail::string_entry)));
+        n.a = static_cast<std::uint32_t>(m_data.size());
+        n.b = static_cast<std::uint32_t>(entries.size());
+        append_bytes(entries.data(), entries.size() * sizeof(detail::string_entry));
+        return add_leaf(n);
+    }
+
+    template <class Pred>
+    program_builder& append(const Pred& pred)
+    {
+        if constexpr (core::is_detected<detail::compound_tag_of, Pred>{})
+        {
+            std::is_same_v<detail::compound_tag_of<Pred>, detail::all_tag> ? begin_all() : begin_any();
+            detail::flat_for_each(pred.m_preds, [&](const auto& child) { append(child); });
+            return end();
+        }
+        else if constexpr (core::is_detected<detail::compare_operator_of, Pred>{})
+        {
+            return compare(detail::comparison_of<detail::compare_operator_of<Pred>>(), program_value(pred.m_value));
+        }
+        else if constexpr (detail::is_negate<Pred>{})
+        {
+            begin_negate();
+            append(pred.m_pred);
+            return end();
+        }
+        else if constexpr (core::is_detected<detail::field_index_of, Pred>{})
+        {
+            begin_field(static_cast<std::uint32_t>(Pred::field_index));
+            append(pred.pred);
+            return end();
+        }
+        else if constexpr (core::is_detected<detail::string_test_of, Pred>{})
+        {
+            return string_test(
+                detail::string_opcode<detail::string_test_of<Pred>>(),
+                detail::pattern_view(pred.m_expected),
+                pred.m_comparison);
+        }
+        else if constexpr (detail::is_program_constant<Pred>)
+        {
+            return compare(comparison::eq, program_value(pred));
+        }
+        else
+        {
+            static_assert(core::always_false<Pred>::value, "predicate cannot be compiled into a program");
+        }
+    }
+
+    auto finish() const -> std::vector<std::byte>
+    {
+        if (!m_open.empty() || m_roots != 1)
+        {
+            throw program_error{ "program must have exactly one complete root node" };
+        }
+        detail::program_header header = {};
+        std::memcpy(header.magic, detail::program_magic, sizeof(header.magic));
+        header.version = detail::program_format_version;
+        header.byte_order = detail::program_byte_order;
+        header.node_count = static_cast<std::uint32_t>(m_nodes.size());
+        header.nodes_offset = sizeof(detail::program_header);
+        header.data_offset = detail::align_to(header.nodes_offset + m_nodes.size() * sizeof(detail::program_node), 8);
+        header.data_size = m_data.size();
+
+        std::vector<std::byte> result(header.data_offset + header.data_size);
+        std::memcpy(result.data(), &header, sizeof(header));
+        std::memcpy(result.data() + header.nodes_offset, m_nodes.data(), m_nodes.size() * sizeof(detail::program_node));
+        std::memcpy(result.data() + header.data_offset, m_data.data(), m_data.size());
+        return result;
+    }
+
+private:
+    struct open_node
+    {
+        std::size_t index;
+        std::uint32_t children;
+    };
+
+    static detail::program_node make_node(opcode op)
+    {
+        detail::program_node n = {};
+        n.op = op;
+        n.size = 1;
+        return n;
+    }
+
+    void count_child()
+    {
+        if (m_open.empty())
+        {
+            ++m_roots;
+        }
+        else
+        {
+            ++m_open.back().children;
+        }
+    }
+
+    program_builder& open(opcode op, std::uint32_t a)
+    {
+        if (m_open.size() + 1 >= detail::program_max_depth)
+        {
+            throw program_error{ "program is nested too deeply" };
+        }
+        count_child();
+        detail::program_node n = make_node(op);
+        n.a = a;
+        m_open.push_back(open_node{ m_nodes.size(), 0 });
+        m_nodes.push_back(n);
+        return *this;
+    }
+
+    program_builder& add_leaf(const detail::program_node& n)
+    {
+        count_child();
+        m_nodes.push_back(n);
+        return *this;
+    }
+
+    void append_bytes(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::byte*>(data);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    template <class T>
+    std::uint32_t add_data(T value)
+    {
+        m_data.resize(detail::align_to(m_data.size(), alignof(T)));
+        const auto offset = static_cast<std::uint32_t>(m_data.size());
+        append_bytes(&value, sizeof(value));
+        return offset;
+    }
+
+    std::uint32_t add_string(std::string_view value)
+    {
+        const auto offset = static_cast<std::uint32_t>(m_data.size());
+        append_bytes(value.data(), value.size());
+        return offset;
+    }
+
+    std::vector<detail::program_node> m_nodes;
+    std::vector<std::byte> m_data;
+    std::vector<open_node> m_open;
+    std::size_t m_roots = 0;
+};
+
+class program
+{
+public:
+    explicit program(std::vector<std::byte> bytes) : m_bytes{ std::move(bytes) }, m_view{ m_bytes.data(), m_bytes.size() }
+    {
+    }
+
+    program(const program& other) : program(other.m_bytes)
+    {
+    }
+
+    program(program&&) = default;
+
+    program& operator=(program other)
+    {
+        std::swap(m_bytes, other.m_bytes);
+        std::swap(m_view, other.m_view);
+        return *this;
+    }
+
+    bool operator()(const program_value& item) const
+    {
+        return m_view(item);
+    }
+
+    const program_view& view() const
+    {
+        return m_view;
+    }
+
+    void save(const std::string& path) const
+    {
+        std::ofstream file{ path, std::ios::binary };
+        file.write(reinterpret_cast<const char*>(m_bytes.data()), static_cast<std::streamsize>(m_bytes.size()));
+        if (!file)
+        {
+            throw program_error{ "cannot write program to " + path };
+        }
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const program& item)
+    {
+        return os << item.m_view;
+    }
+
+private:
+    std::vector<std::byte> m_bytes;
+    program_view m_view;
+};
+
+class mapped_program
+{
+public:
+    explicit mapped_program(const std::string& path) : m_file{ path }, m_view{ m_file.contents().data(), m_file.contents().size() }
+    {
+    }
+
+    bool operator()(const program_value& item) const
+    {
+        return m_view(item);
+    }
+
+    const program_view& view() const
+    {
+        return m_view;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const mapped_program& item)
+    {
+        return os << item.m_view;
+    }
+
+private:
+    mapped_file m_file;
+    program_view m_view;
+};
+
+template <class Pred>
+auto compile_program(const Pred& pred) -> program
+{
+    return program{ program_builder{}.append(pred).finish() };
+}
+
+}  // namespace predicates
+}  // namespace ferrugo
@@ -0,0 +1,692 @@
+#pragma once
+
+#include <ferrugo/predicates/core.hpp>
+#include <ferrugo/predicates/description.hpp>
+#include <ferrugo/predicates/scratch.hpp>
+#include <ferrugo/predicates/segmented_string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+namespace detail
+{
+
+inline void invalid_static_regex(const char* reason)
+{
+    throw std::invalid_argument{ reason };
+}
+
+struct regex_char_set
+{
+    std::uint64_t m_bits[4] = {};
+
+    constexpr void add(unsigned char ch)
+    {
+        m_bits[ch / 64] |= std::uint64_t{ 1 } << (ch % 64);
+    }
+
+    constexpr void add_range(unsigned char first, unsigned char last)
+    {
+        if (first > last)
+        {
+            invalid_static_regex("invalid character range");
+        }
+        for (unsigned ch = first; ch <= last; ++ch)
+        {
+            add(static_cast<unsigned char>(ch));
+        }
+    }
+
+    constexpr void merge(const regex_char_set& other)
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            m_bits[i] |= other.m_bits[i];
+        }
+    }
+
+    constexpr void invert()
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            m_bits[i] = ~m_bits[i];
+        }
+    }
+
+    constexpr bool contains(unsigned char ch) const
+    {
+        return (m_bits[ch / 64] >> (ch % 64)) & 1;
+    }
+
+    static constexpr regex_char_set single(unsigned char ch)
+    {
+        regex_char_set result{};
+        result.add(ch);
+        return result;
+    }
+
+    static constexpr regex_char_set digit()
+    {
+        regex_char_set result{};
+        result.add_range('0', '9');
+        return result;
+    }
+
+    static constexpr regex_char_set word()
+    {
+        regex_char_set result = digit();
+        result.add_range('a', 'z');
+        result.add_range('A', 'Z');
+        result.add('_');
+        return result;
+    }
+
+    static constexpr regex_char_set space()
+    {
+        regex_char_set result{};
+        result.add(' ');
+        result.add_range('\t', '\r');
+        return result;
+    }
+
+    static constexpr regex_char_set any_but_newline()
+    {
+        regex_char_set result{};
+        result.add('\n');
+        result.add('\r');
+        result.invert();
+        return result;
+    }
+};
+
+inline std::size_t count_trailing_zeros(std::uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(bits));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index = 0;
+    _BitScanForward64(&index, bits);
+    return static_cast<std::size_t>(index);
+#else
+    std::size_t result = 0;
+    for (; (bits & 1) == 0; bits >>= 1)
+    {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+template <std::size_t W>
+struct position_set
+{
+    std::uint64_t m_words[W] = {};
+
+    constexpr void set(std::size_t pos)
+    {
+        if (pos < 64 * W)
+        {
+            m_words[pos / 64] |= std::uint64_t{ 1 } << (pos % 64);
+        }
+    }
+
+    constexpr bool test(std::size_t pos) const
+    {
+        return pos < 64 * W && ((m_words[pos / 64] >> (pos % 64)) & 1);
+    }
+
+    constexpr bool any() const
+    {
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            if (m_words[i] != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr position_set& operator|=(const position_set& other)
+    {
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            m_words[i] |= other.m_words[i];
+        }
+        return *this;
+    }
+
+    constexpr position_set& operator&=(const position_set& other)
+    {
+        for (std::size_t i = 0; i < W; ++i)
+        {
+            m_words[i] &= other.m_words[i];
+        }
+        return *this;
+    }
+};
+
+// Glushkov construction: every character class in the pattern becomes one position (state), position 0 is the start
+// state, and no epsilon transitions are needed. With Capacity == 0 the builder only counts positions.
+template <std::size_t W, std::size_t Capacity>
+struct glushkov_builder
+{
+    struct fragment
+    {
+        bool nullable = true;
+        position_set<W> first = {};
+        position_set<W> last = {};
+    };
+
+    std::string_view m_pattern;
+    std::size_t m_pos = 0;
+    std::size_t m_count = 0;
+    position_set<W> m_follow[Capacity + 1] = {};
+    regex_char_set m_classes[Capacity + 1] = {};
+
+    constexpr explicit glushkov_builder(std::string_view pattern) : m_pattern{ pattern }
+    {
+    }
+
+    constexpr fragment parse()
+    {
+        fragment result = parse_alternation();
+        if (m_pos != m_pattern.size())
+        {
+            invalid_static_regex("unmatched ')'");
+        }
+        m_follow[0] = result.first;
+        return result;
+    }
+
+    constexpr bool at_end() const
+    {
+        return m_pos == m_pattern.size();
+    }
+
+    constexpr char peek() const
+    {
+        return m_pattern[m_pos];
+    }
+
+    constexpr char next()
+    {
+        if (at_end())
+        {
+            invalid_static_regex("unexpected end of pattern");
+        }
+        return m_pattern[m_pos++];
+    }
+
+    constexpr void link(const position_set<W>& from, const position_set<W>& to)
+    {
+        for (std::size_t p = 1; p <= m_count && p <= Capacity; ++p)
+        {
+            if (from.test(p))
+            {
+                m_follow[p] |= to;
+            }
+        }
+    }
+
+    constexpr fragment position(const regex_char_set& chars)
+    {
+        ++m_count;
+        if (m_count <= Capacity)
+        {
+            m_classes[m_count] = chars;
+        }
+        fragment result{ false };
+        result.first.set(m_count);
+        result.last.set(m_count);
+        return result;
+    }
+
+    constexpr fragment concat(const fragment& lhs, const fragment& rhs)
+    {
+        link(lhs.last, rhs.first);
+        fragment result{ lhs.nullable && rhs.nullable, lhs.first, rhs.last };
+        if (lhs.nullable)
+        {
+            result.first |= rhs.first;
+        }
+        if (rhs.nullable)
+        {
+            result.last |= lhs.last;
+        }
+        return result;
+    }
+
+    constexpr fragment repeat(fragment frag, bool optional, bool unbounded)
+    {
+        if (unbounded)
+        {
+            link(frag.last, frag.first);
+        }
+        frag.nullable = frag.nullable || optional;
+        return frag;
+    }
+
+    constexpr fragment parse_alternation()
+    {
+        fragment result = parse_sequence();
+        while (!at_end() && peek() == '|')
+        {
+            ++m_pos;
+            const fragment rhs = parse_sequence();
+            result.nullable = result.nullable || rhs.nullable;
+            result.first |= rhs.first;
+            result.last |= rhs.last;
+        }
+        return result;
+    }
+
+    constexpr fragment parse_sequence()
+    {
+        fragment result{};
+        while (!at_end() && peek() != '|' && peek() != ')')
+        {
+            result = concat(result, parse_repeat());
+        }
+        return result;
+    }
+
+    constexpr std::size_t parse_count()
+    {
+        if (at_end() || peek() < '0' || peek() > '9')
+        {
+            invalid_static_regex("invalid repetition count");
+        }
+        std::size_t result = 0;
+        while (!at_end() && peek() >= '0' && peek() <= '9')
+        {
+            result = result * 10 + static_cast<std::size_t>(next() - '0');
+            if (result > 1000)
+            {
+                invalid_static_regex("repetition count too large");
+            }
+        }
+        return result;
+    }
+
+    constexpr fragment parse_repeat()
+    {
+        const std::size_t atom_begin = m_pos;
+        const fragment atom = parse_atom();
+        if (at_end())
+        {
+            return atom;
+        }
+        std::size_t min = 1;
+        std::size_t max = 1;
+        bool unbounded = false;
+        switch (peek())
+        {
+            case '*': min = 0, unbounded = true; break;
+            case '+': unbounded = true; break;
+            case '?': min = 0; break;
+            case '{': break;
+            default: return atom;
+        }
+        if (next() == '{')
+        {
+            min = max = parse_count();
+            if (!at_end() && peek() == ',')
+            {
+                ++m_pos;
+                unbounded = at_end() || peek() == '}';
+                max = unbounded ? min : parse_count();
+            }
+            if (next() != '}')
+            {
+                invalid_static_regex("missing '}'");
+            }
+            if (max < min)
+            {
+                invalid_static_regex("invalid repetition range");
+            }
+        }
+        if (!at_end() && peek() == '?')
+        {
+            ++m_pos;
+        }
+        if (!at_end() && (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{'))
+        {
+            invalid_static_regex("nothing to repeat");
+        }
+        if (max == 0 && !unbounded)
+        {
+            return fragment{};
+        }
+        const std::size_t copies = unbounded ? (min > 0 ? min : 1) : max;
+        const std::size_t resume = m_pos;
+        fragment result{};
+        for (std::size_t i = 0; i < copies; ++i)
+        {
+            fragment copy = atom;
+            if (i != 0)
+            {
+                m_pos = atom_begin;
+                copy = parse_atom();
+            }
+            const bool last = i + 1 == copies;
+            result = concat(result, repeat(copy, i >= min, unbounded && last));
+        }
+        m_pos = resume;
+        return result;
+    }
+
+    constexpr fragment parse_atom()
+    {
+        const char ch = next();
+        switch (ch)
+        {
+            case '(':
+            {
+                if (!at_end() && peek() == '?')
+                {
+                    ++m_pos;
+                    if (next() != ':')
+                    {
+                        invalid_static_regex("unsupported group");
+                    }
+                }
+                const fragment result = parse_alternation();
+                if (at_end() || next() != ')')
+                {
+                    invalid_static_regex("missing ')'");
+                }
+                return result;
+            }
+            case '[': return position(parse_class());
+            case '.': return position(regex_char_set::any_but_newline());
+            case '\\': return position(parse_escape(false));
+            case '^':
+                if (m_pos != 1)
+                {
+                    invalid_static_regex("unsupported anchor");
+                }
+                return fragment{};
+            case '$':
+                if (!at_end())
+                {
+                    invalid_static_regex("unsupported anchor");
+                }
+                return fragment{};
+            case '*':
+            case '+':
+            case '?':
+            case '{': invalid_static_regex("nothing to repeat"); return fragment{};
+            default: return position(regex_char_set::single(static_cast<unsigned char>(ch)));
+        }
+    }
+
+    constexpr regex_char_set parse_escape(bool in_class)
+    {
+        const char ch = next();
+        regex_char_set result{};
+        switch (ch)
+        {
+            case 'd': return regex_char_set::digit();
+            case 'w': return regex_char_set::word();
+            case 's': return regex_char_set::space();
+            case 'D': result = regex_char_set::digit(); break;
+            case 'W': result = regex_char_set::word(); break;
+            case 'S': result = regex_char_set::space(); break;
+            case 'n': return regex_char_set::single('\n');
+            case 'r': return regex_char_set::single('\r');
+            case 't': return regex_char_set::single('\t');
+            case 'f': return regex_char_set::single('\f');
+            case 'v': return regex_char_set::single('\v');
+            case '0': return regex_char_set::single('\0');
+            case 'b': return in_class ? regex_char_set::single('\b') : (invalid_static_regex("unsupported escape"), result);
+            default:
+                if ((ch >= '1' && ch <= '9') || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'))
+                {
+                    invalid_static_regex("unsupported escape");
+                }
+                return regex_char_set::single(static_cast<unsigned char>(ch));
+        }
+        result.invert();
+        return result;
+    }
+
+    constexpr bool is_single(const regex_char_set& chars, unsigned char& ch) const
+    {
+        std::size_t count = 0;
+        for (unsigned c = 0; c < 256; ++c)
+        {
+            if (chars.contains(static_cast<unsigned char>(c)))
+            {
+                ch = static_cast<unsigned char>(c);
+                ++count;
+            }
+        }
+        return count == 1;
+    }
+
+    constexpr regex_char_set parse_class_atom()
+    {
+        const char ch = next();
+        return ch == '\\' ? parse_escape(true) : regex_char_set::single(static_cast<unsigned char>(ch));
+    }
+
+    constexpr regex_char_set parse_class()
+    {
+        const bool negated = !at_end() && peek() == '^';
+        if (negated)
+        {
+            ++m_pos;
+        }
+        regex_char_set result{};
+        while (true)
+        {
+            if (at_end())
+            {
+                invalid_static_regex("missing ']'");
+            }
+            if (peek() == ']')
+            {
+                ++m_pos;
+                break;
+            }
+            const regex_char_set lower = parse_class_atom();
+            if (m_pos + 1 < m_pattern.size() && peek() == '-' && m_pattern[m_pos + 1] != ']')
+            {
+                ++m_pos;
+                const regex_char_set upper = parse_class_atom();
+                unsigned char first = 0;
+                unsigned char last = 0;
+                if (!is_single(lower, first) || !is_single(upper, last))
+                {
+                    invalid_static_regex("invalid character range");
+                }
+                result.add_range(first, last);
+            }
+            else
+            {
+                result.merge(lower);
+            }
+        }
+        if (negated)
+        {
+            result.invert();
+        }
+        return result;
+    }
+};
+
+constexpr std::size_t static_regex_positions(std::string_view pattern)
+{
+    glushkov_builder<1, 0> builder{ pattern };
+    builder.parse();
+    return builder.m_count;
+}
+
+template <std::size_t W, std::size_t P>
+struct static_regex_tables
+{
+    position_set<W> m_follow[P + 1] = {};
+    position_set<W> m_accepts[256] = {};
+    position_set<W> m_final = {};
+};
+
+template <std::size_t W, std::size_t P>
+constexpr auto build_static_regex(std::string_view pattern)
+{
+    glushkov_builder<W, P> builder{ pattern };
+    const auto root = builder.parse();
+    static_regex_tables<W, P> result{};
+    for (std::size_t p = 0; p <= P; ++p)
+    {
+        result.m_follow[p] = builder.m_follow[p];
+    }
+    for (unsigned ch = 0; ch < 256; ++ch)
+    {
+        for (std::size_t p = 1; p <= P; ++p)
+        {
+            if (builder.m_classes[p].contains(static_cast<unsigned char>(ch)))
+            {
+                result.m_accepts[ch].set(p);
+            }
+        }
+    }
+    result.m_final = root.last;
+    if (root.nullable)
+    {
+        result.m_final.set(0);
+    }
+    return result;
+}
+
+template <char... C>
+struct static_regex
+{
+    static constexpr char data[sizeof...(C) + 1] = { C..., '\0' };
+    static constexpr std::string_view pattern = std::string_view{ data, sizeof...(C) };
+    static constexpr std::size_t positions = static_regex_positions(pattern);
+    static constexpr std::size_t words = (positions + 64) / 64;
+    static constexpr auto tables = build_static_regex<words, positions>(pattern);
+
+    template <class Iter>
+    static bool match(Iter first, Iter last)
+    {
+        position_set<words> current{};
+        current.set(0);
+        for (; first != last; ++first)
+        {
+            position_set<words> next{};
+            for (std::size_t w = 0; w < words; ++w)
+            {
+                for (std::uint64_t bits = current.m_words[w]; bits != 0; bits &= bits - 1)
+                {
+                    next |= tables.m_follow[w * 64 + count_trailing_zeros(bits)];
+                }
+            }
+            next &= tables.m_accepts[static_cast<unsigned char>(*first)];
+            if (!next.any())
+            {
+                return false;
+            }
+            current = next;
+        }
+        current &= tables.m_final;
+        return current.any();
+    }
+};
+
+struct string_matches_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 16 * scan_cost;
+
+        std::regex m_regex;
+
+        template <class Iter>
+        bool match(Iter first, Iter last) const
+        {
+            const evaluation_scope scope;
+            std::match_results<Iter, scratch_allocator<std::sub_match<Iter>>> results;
+            return std::regex_match(first, last, results, m_regex);
+        }
+
+        bool operator()(std::string_view actual) const
+        {
+            return match(actual.begin(), actual.end());
+        }
+
+        bool operator()(const segmented_string_view& actual) const
+        {
+            return match(actual.begin(), actual.end());
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(string_matches)";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const impl&)
+        {
+            return write_text(out, "(string_matches)");
+        }
+    };
+
+    template <char... C>
+    struct static_impl
+    {
+        static constexpr std::size_t cost = 2 * scan_cost;
+
+        bool operator()(std::string_view actual) const
+        {
+            return static_regex<C...>::match(actual.begin(), actual.end());
+        }
+
+        bool operator()(const segmented_string_view& actual) const
+        {
+            return static_regex<C...>::match(actual.begin(), actual.end());
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const static_impl&)
+        {
+            return os << "(string_matches \"" << static_regex<C...>::pattern << "\")";
+        }
+    };
+
+    auto operator()(std::regex regex) const
+    {
+        return impl{ std::move(regex) };
+    }
+
+    auto operator()(const std::string& regex) const
+    {
+        return (*this)(std::regex(regex));
+    }
+
+    template <template <char...> class Str, char... C>
+    auto operator()(Str<C...>) const -> static_impl<C...>
+    {
+        static_cast<void>(static_regex<C...>::tables);
+        return {};
+    }
+};
+
+}  // namespace detail
+
+inline constexpr auto string_matches = detail::string_matches_fn{};
+
+}  // namespace predicates
+}  // namespace ferrugo
@@ -0,0 +1,627 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <ferrugo/predicates/core.hpp>
+#include <ferrugo/predicates/type_erasure.hpp>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+namespace detail
+{
+
+template <class T>
+using is_hashable = decltype(std::hash<T>{}(std::declval<const T&>()));
+
+template <class L, class R>
+using is_less_comparable = decltype(std::declval<L>() < std::declval<R>());
+
+template <class V>
+struct key_bound
+{
+    V value;
+    bool inclusive;
+};
+
+template <class V>
+struct key_constraint
+{
+    std::vector<V> values;
+    std::optional<key_bound<V>> lower;
+    std::optional<key_bound<V>> upper;
+
+    bool is_values() const
+    {
+        return !values.empty() && !lower && !upper;
+    }
+
+    bool is_bounds() const
+    {
+        return values.empty() && (lower || upper);
+    }
+};
+
+template <class V, class C>
+std::optional<V> to_key(const C& constant)
+{
+    if constexpr (std::is_same_v<V, C>)
+    {
+        return constant;
+    }
+    else if constexpr (
+        std::is_integral_v<V> && std::is_integral_v<C> && !std::is_same_v<V, bool> && !std::is_same_v<C, bool>
+        && std::is_signed_v<V> == std::is_signed_v<C>)
+    {
+        const V key = static_cast<V>(constant);
+        if (static_cast<C>(key) == constant && (key < V{}) == (constant < C{}))
+        {
+            return key;
+        }
+        return std::nullopt;
+    }
+    else if constexpr (!std::is_arithmetic_v<V> && !std::is_arithmetic_v<C> && std::is_constructible_v<V, const C&>)
+    {
+        return V(constant);
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+template <class V, class Pred>
+std::optional<key_constraint<V>> extract_constraint(const Pred& pred)
+{
+    constexpr bool is_ordered = core::is_detected<is_less_comparable, const V&, const V&>{};
+    if constexpr (core::is_detected<compare_operator_of, Pred>{})
+    {
+        using op_t = compare_operator_of<Pred>;
+        const std::optional<V> key = to_key<V>(pred.m_value);
+        if (!key)
+        {
+            return std::nullopt;
+        }
+        key_constraint<V> result;
+        if constexpr (std::is_same_v<op_t, std::equal_to<>>)
+        {
+            result.values.push_back(*key);
+            return result;
+        }
+        else if constexpr (is_ordered && (std::is_same_v<op_t, std::greater<>> || std::is_same_v<op_t, std::greater_equal<>>))
+        {
+            result.lower = key_bound<V>{ *key, std::is_same_v<op_t, std::greater_equal<>> };
+            return result;
+        }
+        else if constexpr (is_ordered && (std::is_same_v<op_t, std::less<>> || std::is_same_v<op_t, std::less_equal<>>))
+        {
+            result.upper = key_bound<V>{ *key, std::is_same_v<op_t, std::less_equal<>> };
+            return result;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+    else if constexpr (core::is_detected<compound_tag_of, Pred>{})
+    {
+        std::optional<key_constraint<V>> result = key_constraint<V>{};
+        const auto combine = [&](const auto& child)
+        {
+            const std::optional<key_constraint<V>> c = extract_constraint<V>(child);
+            if (!result || !c)
+            {
+                result = std::nullopt;
+            }
+            else if constexpr (std::is_same_v<compound_tag_of<Pred>, any_tag>)
+            {
+                if (!c->is_values())
+                {
+                    result = std::nullopt;
+                    return;
+                }
+                result->values.insert(result->values.end(), c->values.begin(), c->values.end());
+            }
+            else if constexpr (flat_size_v<std::decay_t<decltype(pred.m_preds)>> == 1)
+            {
+                result = c;
+            }
+            else
+            {
+                if (!c->is_bounds() || (c->lower && result->lower) || (c->upper && result->upper))
+                {
+                    result = std::nullopt;
+                    return;
+                }
+                result->lower = c->lower ? c->lower : result->lower;
+                result->upper = c->upper ? c->upper : result->upper;
+            }
+        };
+        flat_for_each(pred.m_preds, combine);
+        if (result && !result->is_values() && !result->is_bounds())
+        {
+            return std::nullopt;
+        }
+        return result;
+    }
+    else if constexpr (
+        !std::is_invocable_v<const Pred&, const V&> && core::is_detected<is_equality_comparable, const V&, const Pred&>{})
+    {
+        const std::optional<V> key = to_key<V>(pred);
+        if (!key)
+        {
+            return std::nullopt;
+        }
+        key_constraint<V> result;
+        result.values.push_back(*key);
+        return result;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+}
+
+template <class T, class Pred>
+constexpr bool is_indexable_projection()
+{
+    if constexpr (core::is_detected<projection_of, Pred>{})
+    {
+        using func_t = projection_of<Pred>;
+        if constexpr (std::is_invocable_v<const func_t&, const T&>)
+        {
+            using value_t = std::decay_t<std::invoke_result_t<const func_t&, const T&>>;
+            return (std::is_empty_v<func_t> || core::is_detected<is_equality_comparable, const func_t&, const func_t&>{})
+                   && (core::is_detected<is_hashable, value_t>{}
+                       || core::is_detected<is_less_comparable, const value_t&, const value_t&>{});
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <class T>
+struct rule_index
+{
+    virtual ~rule_index() = default;
+
+    virtual void match(const T& item, std::vector<std::size_t>& out) const = 0;
+};
+
+template <class T>
+struct resource_deleter
+{
+    std::pmr::memory_resource* m_resource;
+    std::size_t m_size;
+    std::size_t m_alignment;
+
+    void operator()(T* ptr) const
+    {
+        ptr->~T();
+        m_resource->deallocate(ptr, m_size, m_alignment);
+    }
+};
+
+template <class T>
+using resource_ptr = std::unique_ptr<T, resource_deleter<T>>;
+
+template <class Base, class Derived, class... Args>
+auto make_resource_ptr(std::pmr::memory_resource* resource, Args&&... args) -> resource_ptr<Base>
+{
+    void* memory = resource->allocate(sizeof(Derived), alignof(Derived));
+    try
+    {
+        Derived* object = ::new (memory) Derived(std::forward<Args>(args)...);
+        return resource_ptr<Base>{ object, resource_deleter<Base>{ resource, sizeof(Derived), alignof(Derived) } };
+    }
+    catch (...)
+    {
+        resource->deallocate(memory, sizeof(Derived), alignof(Derived));
+        throw;
+    }
+}
+
+template <class T, class Func, class V>
+struct projection_index : rule_index<T>
+{
+    struct candidate
+    {
+        std::size_t m_id;
+        pmr::predicate<T> m_residual;
+
+        void match(const T& item, std::vector<std::size_t>& out) const
+        {
+            if (!m_residual || m_residual(item))
+            {
+                out.push_back(m_id);
+            }
+        }
+    };
+
+    struct interval
+    {
+        std::optional<key_bound<V>> m_lower;
+        std::optional<key_bound<V>> m_upper;
+        candidate m_candidate;
+    };
+
+    using value_map_t = std::conditional_t<
+        core::is_detected<is_hashable, V>{},
+        std::pmr::unordered_map<V, std::pmr::vector<candidate>>,
+        std::pmr::map<V, std::pmr::vector<candidate>>>;
+
+    Func m_func;
+    value_map_t m_values;
+    std::pmr::vector<interval> m_lower_bounded;
+    std::pmr::vector<interval> m_upper_bounded;
+    std::pmr::vector<interval> m_bounded;
+    std::pmr::deque<std::pmr::string> m_strings;
+
+    projection_index(Func func, std::pmr::memory_resource* resource)
+        : m_func{ std::move(func) }
+        , m_values{ resource }
+        , m_lower_bounded{ resource }
+        , m_upper_bounded{ resource }
+        , m_bounded{ resource }
+        , m_strings{ resource }
+    {
+    }
+
+    void add(key_constraint<V> constraint, candidate c)
+    {
+        for (V& value : constraint.values)
+        {
+            const auto alloc = m_values.get_allocator();
+            m_values[store(value)].push_back(candidate{ c.m_id, pmr::predicate<T>{ c.m_residual, alloc } });
+        }
+        if (constraint.lower)
+        {
+            constraint.lower->value = store(constraint.lower->value);
+        }
+        if (constraint.upper)
+        {
+            constraint.upper->value = store(constraint.upper->value);
+        }
+        if constexpr (core::is_detected<is_less_comparable, const V&, const V&>{})
+        {
+            const auto by_lower = [](const interval& lhs, const interval& rhs) { return lhs.m_lower->value < rhs.m_lower->value; };
+            const auto by_upper = [](const interval& lhs, const interval& rhs) { return lhs.m_upper->value < rhs.m_upper->value; };
+            if (constraint.lower && constraint.upper)
+            {
+                insert_sorted(m_bounded, interval{ constraint.lower, constraint.upper, std::move(c) }, by_lower);
+            }
+            else if (constraint.lower)
+            {
+                insert_sorted(m_lower_bounded, interval{ constraint.lower, std::nullopt, std::move(c) }, by_lower);
+            }
+            else if (constraint.upper)
+            {
+                insert_sorted(m_upper_bounded, interval{ std::nullopt, constraint.upper, std::move(c) }, by_upper);
+            }
+        }
+    }
+
+    void match(const T& item, std::vector<std::size_t>& out) const override
+    {
+        decltype(auto) projected = std::invoke(m_func, item);
+        const V& value = projected;
+        if (!m_values.empty())
+        {
+            const auto it = m_values.find(value);
+            if (it != m_values.end())
+            {
+                for (const candidate& c : it->second)
+                {
+                    c.match(item, out);
+                }
+            }
+        }
+        if constexpr (core::is_detected<is_less_comparable, const V&, const V&>{})
+        {
+            const auto lower_end = std::partition_point(
+                m_lower_bounded.begin(),
+                m_lower_bounded.end(),
+                [&](const interval& i) { return !(value < i.m_lower->value); });
+            for (auto it = m_lower_bounded.begin(); it != lower_end; ++it)
+            {
+                if (above(*it->m_lower, value))
+                {
+                    it->m_candidate.match(item, out);
+                }
+            }
+            const auto upper_begin = std::partition_point(
+                m_upper_bounded.begin(),
+                m_upper_bounded.end(),
+                [&](const interval& i) { return i.m_upper->value < value; });
+            for (auto it = upper_begin; it != m_upper_bounded.end(); ++it)
+            {
+                if (below(*it->m_upper, value))
+                {
+                    it->m_candidate.match(item, out);
+                }
+            }
+            const auto bounded_end = std::partition_point(
+                m_bounded.begin(), m_bounded.end(), [&](const interval& i) { return !(value < i.m_lower->value); });
+            for (auto it = m_bounded.begin(); it != bounded_end; ++it)
+            {
+                if (above(*it->m_lower, value) && below(*it->m_upper, value))
+                {
+                    it->m_candidate.match(item, out);
+                }
+            }
+        }
+    }
+
+    static bool above(const key_bound<V>& bound, const V& value)
+    {
+        return bound.inclusive ? !(value < bound.value) : bound.value < value;
+    }
+
+    static bool below(const key_bound<V>& bound, const V& value)
+    {
+        return bound.inclusive ? !(bound.value < value) : value < bound.value;
+    }
+
+    template <class Compare>
+    static void insert_sorted(std::pmr::vector<interval>& intervals, interval i, Compare compare)
+    {
+        const auto pos = std::upper_bound(intervals.begin(), intervals.end(), i, compare);
+        intervals.insert(pos, std::move(i));
+    }
+
+    V store(const V& value)
+    {
+        if constexpr (std::is_same_v<V, std::string_view>)
+        {
+            return m_strings.emplace_back(value);
+        }
+        else
+        {
+            return value;
+        }
+    }
+};
+
+}  // namespace detail
+
+template <class T>
+class rule_set
+{
+public:
+    using rule_id = std::size_t;
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    rule_set() : rule_set(std::pmr::get_default_resource())
+    {
+    }
+
+    explicit rule_set(std::pmr::memory_resource* resource)
+        : m_resource{ resource }
+        , m_indices{ resource }
+        , m_fallback{ resource }
+    {
+    }
+
+    template <class Pred>
+    void add(rule_id id, Pred pred)
+    {
+        if (!try_index(id, pred))
+        {
+            m_fallback.emplace_back(id, pmr::predicate<T>{ std::move(pred), m_resource });
+        }
+        ++m_size;
+    }
+
+    allocator_type get_allocator() const
+    {
+        return allocator_type{ m_resource };
+    }
+
+    void match(const T& item, std::vector<rule_id>& out) const
+    {
+        out.clear();
+        for (const auto& index : m_indices)
+        {
+            index->match(item, out);
+        }
+        for (const auto& rule : m_fallback)
+        {
+            if (rule.second(item))
+            {
+                out.push_back(rule.first);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    auto match(const T& item) const -> std::vector<rule_id>
+    {
+        std::vector<rule_id> result;
+        match(item, result);
+        return result;
+    }
+
+    template <class Iter>
+    void match(Iter begin, Iter end, std::vector<std::vector<rule_id>>& out) const
+    {
+        out.resize(std::distance(begin, end));
+        for (auto& ids : out)
+        {
+            ids.clear();
+        }
+        for (const auto& index : m_indices)
+        {
+            std::size_t n = 0;
+            for (auto it = begin; it != end; ++it, ++n)
+            {
+                index->match(*it, out[n]);
+            }
+        }
+        std::size_t n = 0;
+        for (auto it = begin; it != end; ++it, ++n)
+        {
+            for (const auto& rule : m_fallback)
+            {
+                if (rule.second(*it))
+                {
+                    out[n].push_back(rule.first);
+                }
+            }
+            std::sort(out[n].begin(), out[n].end());
+            out[n].erase(std::unique(out[n].begin(), out[n].end()), out[n].end());
+        }
+    }
+
+    template <class Range>
+    auto match_each(const Range& items) const -> std::vector<std::vector<rule_id>>
+    {
+        std::vector<std::vector<rule_id>> result;
+        match(std::begin(items), std::end(items), result);
+        return result;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    std::size_t indexed_count() const
+    {
+        return m_size - m_fallback.size();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const rule_set& item)
+    {
+        return os << "rule_set<" << ::ferrugo::core::type_name<T>() << ">";
+    }
+
+private:
+    template <class Pred>
+    bool try_index(rule_id id, const Pred& pred)
+    {
+        if constexpr (detail::is_indexable_projection<T, Pred>())
+        {
+            return try_index_projection(id, pred, pmr::predicate<T>{ m_resource });
+        }
+        else if constexpr (core::is_detected<detail::compound_tag_of, Pred>{})
+        {
+            if constexpr (std::is_same_v<detail::compound_tag_of<Pred>, detail::all_tag>)
+            {
+                return detail::index_fold<false, detail::flat_size_v<decltype(pred.m_preds)>>(
+                    [&](auto i) { return try_index_child_at<decltype(i)::value>(id, pred); });
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template <std::size_t I, class Pred>
+    bool try_index_child_at(rule_id id, const Pred& pred)
+    {
+        using child_t = detail::flat_element_t<I, decltype(pred.m_preds)>;
+        if constexpr (detail::is_indexable_projection<T, child_t>())
+        {
+            return try_index_projection(id, detail::flat_get<I>(pred.m_preds), residual<I>(pred.m_preds));
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template <std::size_t Skip, class Storage>
+    auto residual(const Storage& preds) const -> pmr::predicate<T>
+    {
+        if constexpr (detail::flat_size_v<Storage> == 1)
+        {
+            return pmr::predicate<T>{ m_resource };
+        }
+        else
+        {
+            return pmr::predicate<T>{
+                std::apply(all, without<Skip>(preds, std::make_index_sequence<detail::flat_size_v<Storage>>{})), m_resource
+            };
+        }
+    }
+
+    template <std::size_t Skip, class Storage, std::size_t... I>
+    static auto without(const Storage& preds, std::index_sequence<I...>)
+    {
+        return std::tuple_cat(without_at<Skip, I>(preds)...);
+    }
+
+    template <std::size_t Skip, std::size_t I, class Storage>
+    static auto without_at(const Storage& preds)
+    {
+        if constexpr (I == Skip)
+        {
+            return std::tuple<>{};
+        }
+        else
+        {
+            return std::make_tuple(detail::flat_get<I>(preds));
+        }
+    }
+
+    template <class Pred>
+    bool try_index_projection(rule_id id, const Pred& pred, pmr::predicate<T> residual)
+    {
+        using func_t = detail::projection_of<Pred>;
+        using value_t = std::decay_t<std::invoke_result_t<const func_t&, const T&>>;
+        using index_t = detail::projection_index<T, func_t, value_t>;
+
+        std::optional<detail::key_constraint<value_t>> constraint = detail::extract_constraint<value_t>(pred.m_pred);
+        if (!constraint)
+        {
+            return false;
+        }
+        index_t* index = nullptr;
+        for (const auto& existing : m_indices)
+        {
+            auto* candidate = dynamic_cast<index_t*>(existing.get());
+            if (candidate && detail::same_projection(candidate->m_func, pred.m_func))
+            {
+                index = candidate;
+                break;
+            }
+        }
+        if (!index)
+        {
+            auto created = detail::make_resource_ptr<detail::rule_index<T>, index_t>(m_resource, pred.m_func, m_resource);
+            index = static_cast<index_t*>(created.get());
+            m_indices.push_back(std::move(created));
+        }
+        index->add(std::move(*constraint), typename index_t::candidate{ id, std::move(residual) });
+        return true;
+    }
+
+    std::pmr::memory_resource* m_resource;
+    std::pmr::vector<detail::resource_ptr<detail::rule_index<T>>> m_indices;
+    std::pmr::vector<std::pair<rule_id, pmr::predicate<T>>> m_fallback;
+    std::size_t m_size = 0;
+};
+
+}  // namespace predicates
+}  // namespace ferrugo
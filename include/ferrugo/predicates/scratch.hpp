@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ferrugo/core/type_traits.hpp>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+class scratch_arena
+{
+public:
+    struct marker
+    {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    static constexpr std::size_t initial_block_size = 4096;
+
+    static scratch_arena& current()
+    {
+        thread_local scratch_arena arena;
+        return arena;
+    }
+
+    scratch_arena() = default;
+    scratch_arena(const scratch_arena&) = delete;
+    scratch_arena& operator=(const scratch_arena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        while (true)
+        {
+            if (m_block < m_blocks.size())
+            {
+                const block& b = m_blocks[m_block];
+                const auto base = reinterpret_cast<std::uintptr_t>(b.m_data.get());
+                const std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(std::uintptr_t{ alignment } - 1);
+                if (aligned + size <= base + b.m_size)
+                {
+                    m_offset = aligned + size - base;
+                    return reinterpret_cast<void*>(aligned);
+                }
+                if (m_block + 1 < m_blocks.size() && m_blocks[m_block + 1].m_size >= size + alignment)
+                {
+                    ++m_block;
+                    m_offset = 0;
+                    continue;
+                }
+            }
+            add_block(size + alignment);
+        }
+    }
+
+    void deallocate(void* ptr, std::size_t size) noexcept
+    {
+        if (m_block < m_blocks.size()
+            && static_cast<std::byte*>(ptr) + size == m_blocks[m_block].m_data.get() + m_offset)
+        {
+            m_offset -= size;
+        }
+    }
+
+    marker mark() const
+    {
+        return marker{ m_block, m_offset };
+    }
+
+    void release(const marker& m)
+    {
+        m_block = m.block;
+        m_offset = m.offset;
+    }
+
+    std::size_t capacity() const
+    {
+        std::size_t result = 0;
+        for (const block& b : m_blocks)
+        {
+            result += b.m_size;
+        }
+        return result;
+    }
+
+private:
+    struct block
+    {
+        std::unique_ptr<std::byte[]> m_data;
+        std::size_t m_size;
+    };
+
+    void add_block(std::size_t min_size)
+    {
+        const std::size_t last_size = m_blocks.empty() ? 0 : m_blocks.back().m_size;
+        const std::size_t size = std::max({ min_size, initial_block_size, 2 * last_size });
+        const std::size_t position = m_blocks.empty() ? 0 : m_block + 1;
+        m_blocks.insert(
+            m_blocks.begin() + static_cast<std::ptrdiff_t>(position), block{ std::make_unique<std::byte[]>(size), size });
+        m_block = position;
+        m_offset = 0;
+    }
+
+    std::vector<block> m_blocks;
+    std::size_t m_block = 0;
+    std::size_t m_offset = 0;
+};
+
+class evaluation_scope
+{
+public:
+    evaluation_scope() : m_arena{ scratch_arena::current() }, m_marker{ m_arena.mark() }
+    {
+    }
+
+    evaluation_scope(const evaluation_scope&) = delete;
+    evaluation_scope& operator=(const evaluation_scope&) = delete;
+
+    ~evaluation_scope()
+    {
+        m_arena.release(m_marker);
+    }
+
+    scratch_arena& arena() const
+    {
+        return m_arena;
+    }
+
+private:
+    scratch_arena& m_arena;
+    scratch_arena::marker m_marker;
+};
+
+template <class T>
+class scratch_allocator
+{
+public:
+    using value_type = T;
+
+    scratch_allocator() : m_arena{ &scratch_arena::current() }
+    {
+    }
+
+    explicit scratch_allocator(scratch_arena& arena) : m_arena{ &arena }
+    {
+    }
+
+    template <class U>
+    scratch_allocator(const scratch_allocator<U>& other) : m_arena{ other.arena() }
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        m_arena->deallocate(ptr, n * sizeof(T));
+    }
+
+    scratch_arena* arena() const
+    {
+        return m_arena;
+    }
+
+    template <class U>
+    friend bool operator==(const scratch_allocator& lhs, const scratch_allocator<U>& rhs)
+    {
+        return lhs.arena() == rhs.arena();
+    }
+
+    template <class U>
+    friend bool operator!=(const scratch_allocator& lhs, const scratch_allocator<U>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    scratch_arena* m_arena;
+};
+
+template <class T>
+struct is_scratch_allocator : std::false_type
+{
+};
+
+template <class T>
+struct is_scratch_allocator<scratch_allocator<T>> : std::true_type
+{
+};
+
+namespace detail
+{
+
+template <class T>
+using allocator_of = typename T::allocator_type;
+
+}  // namespace detail
+
+template <class T>
+constexpr bool uses_scratch_arena()
+{
+    if constexpr (::ferrugo::core::is_detected<detail::allocator_of, std::decay_t<T>>{})
+    {
+        return is_scratch_allocator<detail::allocator_of<std::decay_t<T>>>{};
+    }
+    else
+    {
+        return false;
+    }
+}
+
+using scratch_string = std::basic_string<char, std::char_traits<char>, scratch_allocator<char>>;
+
+template <class T>
+using scratch_vector = std::vector<T, scratch_allocator<T>>;
+
+}  // namespace predicates
+}  // namespace ferrugo
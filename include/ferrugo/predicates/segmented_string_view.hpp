@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+class segmented_string_view
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char*;
+        using reference = const char&;
+
+        const_iterator() = default;
+
+        const_iterator(const std::string_view* segments, std::size_t count, std::size_t segment, std::size_t offset)
+            : m_segments{ segments }
+            , m_count{ count }
+            , m_segment{ segment }
+            , m_offset{ offset }
+        {
+            skip_empty();
+        }
+
+        reference operator*() const
+        {
+            return m_segments[m_segment][m_offset];
+        }
+
+        const_iterator& operator++()
+        {
+            if (++m_offset == m_segments[m_segment].size())
+            {
+                ++m_segment;
+                m_offset = 0;
+                skip_empty();
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        const_iterator& operator--()
+        {
+            if (m_offset == 0)
+            {
+                do
+                {
+                    --m_segment;
+                } while (m_segments[m_segment].empty());
+                m_offset = m_segments[m_segment].size();
+            }
+            --m_offset;
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator result = *this;
+            --*this;
+            return result;
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs)
+        {
+            return lhs.m_segment == rhs.m_segment && lhs.m_offset == rhs.m_offset;
+        }
+
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        void skip_empty()
+        {
+            while (m_segment < m_count && m_segments[m_segment].empty())
+            {
+                ++m_segment;
+            }
+        }
+
+        const std::string_view* m_segments = nullptr;
+        std::size_t m_count = 0;
+        std::size_t m_segment = 0;
+        std::size_t m_offset = 0;
+    };
+
+    using iterator = const_iterator;
+    using value_type = char;
+    using size_type = std::size_t;
+
+    segmented_string_view() = default;
+
+    segmented_string_view(const std::string_view* segments, std::size_t count) : m_segments{ segments }, m_count{ count }
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_size += segments[i].size();
+        }
+    }
+
+    template <
+        class Range,
+        class = std::enable_if_t<
+            std::is_convertible_v<decltype(std::data(std::declval<const Range&>())), const std::string_view*>>>
+    explicit segmented_string_view(const Range& segments) : segmented_string_view(std::data(segments), std::size(segments))
+    {
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{ m_segments, m_count, 0, 0 };
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{ m_segments, m_count, m_count, 0 };
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    const std::string_view* segments() const
+    {
+        return m_segments;
+    }
+
+    std::size_t segment_count() const
+    {
+        return m_count;
+    }
+
+    template <class Func>
+    bool visit(std::size_t pos, std::size_t count, Func&& func) const
+    {
+        for (std::size_t i = 0; i < m_count && count > 0; ++i)
+        {
+            const std::string_view segment = m_segments[i];
+            if (pos >= segment.size())
+            {
+                pos -= segment.size();
+                continue;
+            }
+            const std::string_view chunk = segment.substr(pos, count);
+            if (!func(chunk))
+            {
+                return false;
+            }
+            count -= chunk.size();
+            pos = 0;
+        }
+        return true;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const segmented_string_view& item)
+    {
+        for (std::size_t i = 0; i < item.m_count; ++i)
+        {
+            os << item.m_segments[i];
+        }
+        return os;
+    }
+
+private:
+    const std::string_view* m_segments = nullptr;
+    std::size_t m_count = 0;
+    std::size_t m_size = 0;
+};
+
+}  // namespace predicates
+}  // namespace ferrugo
@@ -0,0 +1,540 @@
+#pragma once
+
+#include <cctype>
+#include <ferrugo/predicates/core.hpp>
+#include <ferrugo/predicates/description.hpp>
+#include <ferrugo/predicates/segmented_string_view.hpp>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+enum class string_comparison
+{
+    case_sensitive,
+    case_insensitive
+};
+
+inline std::string_view comparison_name(const string_comparison item)
+{
+    switch (item)
+    {
+        case string_comparison::case_insensitive: return "case_insensitive";
+        case string_comparison::case_sensitive: return "case_sensitive";
+    }
+    return {};
+}
+
+inline std::ostream& operator<<(std::ostream& os, const string_comparison item)
+{
+    return os << comparison_name(item);
+}
+
+namespace detail
+{
+
+template <char... C>
+struct static_pattern
+{
+    static constexpr char data[sizeof...(C) + 1] = { C..., '\0' };
+
+    static constexpr std::string_view view()
+    {
+        return std::string_view{ data, sizeof...(C) };
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const static_pattern&)
+    {
+        return os << view();
+    }
+};
+
+inline std::string_view pattern_view(const std::string& pattern)
+{
+    return pattern;
+}
+
+inline std::string_view pattern_view(std::string_view pattern)
+{
+    return pattern;
+}
+
+template <char... C>
+constexpr std::string_view pattern_view(const static_pattern<C...>&)
+{
+    return static_pattern<C...>::view();
+}
+
+inline char fold_case(char ch, string_comparison comparison)
+{
+    return comparison == string_comparison::case_insensitive
+               ? static_cast<char>(std::tolower(static_cast<unsigned char>(ch)))
+               : ch;
+}
+
+template <class Out, class Pattern>
+Out write_string_test(Out out, std::string_view name, const Pattern& expected, string_comparison comparison)
+{
+    out = write_text(write_text(write_text(out, "("), name), " ");
+    out = write_text(write_text(out, comparison_name(comparison)), " \"");
+    return write_text(write_text(out, pattern_view(expected)), "\")");
+}
+
+struct char_equal
+{
+    string_comparison m_comparison;
+
+    bool operator()(char lt, char rt) const
+    {
+        return fold_case(lt, m_comparison) == fold_case(rt, m_comparison);
+    }
+};
+
+inline bool segment_equal(std::string_view actual, std::string_view expected, string_comparison comparison)
+{
+    return comparison == string_comparison::case_sensitive
+               ? actual == expected
+               : std::equal(
+                   actual.begin(), actual.end(), expected.begin(), expected.end(), char_equal{ comparison });
+}
+
+inline bool segments_equal(
+    const segmented_string_view& actual, std::size_t pos, std::string_view expected, string_comparison comparison)
+{
+    return actual.visit(
+        pos,
+        expected.size(),
+        [&](std::string_view chunk)
+        {
+            const bool result = segment_equal(chunk, expected.substr(0, chunk.size()), comparison);
+            expected.remove_prefix(chunk.size());
+            return result;
+        });
+}
+
+class kmp_searcher
+{
+public:
+    kmp_searcher(std::string_view pattern, string_comparison comparison) : m_failure(pattern.size(), 0)
+    {
+        const char_equal equal{ comparison };
+        for (std::size_t i = 1, k = 0; i < pattern.size(); ++i)
+        {
+            while (k > 0 && !equal(pattern[i], pattern[k]))
+            {
+                k = m_failure[k - 1];
+            }
+            if (equal(pattern[i], pattern[k]))
+            {
+                ++k;
+            }
+            m_failure[i] = k;
+        }
+    }
+
+    bool search(const segmented_string_view& text, std::string_view pattern, string_comparison comparison) const
+    {
+        if (pattern.empty())
+        {
+            return true;
+        }
+        const char_equal equal{ comparison };
+        std::size_t matched = 0;
+        for (std::size_t i = 0; i < text.segment_count(); ++i)
+        {
+            for (const char ch : text.segments()[i])
+            {
+                while (matched > 0 && !equal(pattern[matched], ch))
+                {
+                    matched = m_failure[matched - 1];
+                }
+                if (equal(pattern[matched], ch) && ++matched == pattern.size())
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    std::vector<std::size_t> m_failure;
+};
+
+template <class Test>
+struct string_test_fn
+{
+    auto operator()(std::string expected, string_comparison comparison) const
+    {
+        return Test::impl::create(std::move(expected), comparison);
+    }
+
+    template <class Pattern>
+    auto operator()(std::reference_wrapper<Pattern> expected, string_comparison comparison) const
+    {
+        using impl_t = typename Test::template basic_impl<std::string_view>;
+        return impl_t::create(std::string_view{ expected.get() }, comparison);
+    }
+
+    template <template <char...> class Str, char... C>
+    auto operator()(Str<C...>, string_comparison comparison) const
+    {
+        using impl_t = typename Test::template basic_impl<static_pattern<C...>>;
+        return impl_t::create(static_pattern<C...>{}, comparison);
+    }
+};
+
+struct string_is_fn : string_test_fn<string_is_fn>
+{
+    template <class Pattern>
+    struct basic_impl
+    {
+        using string_test_type = string_is_fn;
+        static constexpr std::size_t cost = 8;
+
+        Pattern m_expected;
+        string_comparison m_comparison;
+
+        static basic_impl create(Pattern expected, string_comparison comparison)
+        {
+            return basic_impl{ std::move(expected), comparison };
+        }
+
+        bool operator()(std::string_view actual) const
+        {
+            return segment_equal(actual, pattern_view(m_expected), m_comparison);
+        }
+
+        bool operator()(const segmented_string_view& actual) const
+        {
+            const std::string_view expected = pattern_view(m_expected);
+            return actual.size() == expected.size() && segments_equal(actual, 0, expected, m_comparison);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const basic_impl& item)
+        {
+            return os << "(string_is " << item.m_comparison << " \"" << item.m_expected << "\")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const basic_impl& item)
+        {
+            return write_string_test(out, "string_is", item.m_expected, item.m_comparison);
+        }
+    };
+
+    using impl = basic_impl<std::string>;
+};
+
+struct string_starts_with_fn : string_test_fn<string_starts_with_fn>
+{
+    template <class Pattern>
+    struct basic_impl
+    {
+        using string_test_type = string_starts_with_fn;
+        static constexpr std::size_t cost = 8;
+
+        Pattern m_expected;
+        string_comparison m_comparison;
+
+        static basic_impl create(Pattern expected, string_comparison comparison)
+        {
+            return basic_impl{ std::move(expected), comparison };
+        }
+
+        bool operator()(std::string_view actual) const
+        {
+            const std::string_view expected = pattern_view(m_expected);
+            return actual.size() >= expected.size()
+                   && segment_equal(actual.substr(0, expected.size()), expected, m_comparison);
+        }
+
+        bool operator()(const segmented_string_view& actual) const
+        {
+            const std::string_view expected = pattern_view(m_expected);
+            return actual.size() >= expected.size() && segments_equal(actual, 0, expected, m_comparison);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const basic_impl& item)
+        {
+            return os << "(string_starts_with " << item.m_comparison << " \"" << item.m_expected << "\")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const basic_impl& item)
+        {
+            return write_string_test(out, "string_starts_with", item.m_expected, item.m_comparison);
+        }
+    };
+
+    using impl = basic_impl<std::string>;
+};
+
+struct string_ends_with_fn : string_test_fn<string_ends_with_fn>
+{
+    template <class Pattern>
+    struct basic_impl
+    {
+        using string_test_type = string_ends_with_fn;
+        static constexpr std::size_t cost = 8;
+
+        Pattern m_expected;
+        string_comparison m_comparison;
+
+        static basic_impl create(Pattern expected, string_comparison comparison)
+        {
+            return basic_impl{ std::move(expected), comparison };
+        }
+
+        bool operator()(std::string_view actual) const
+        {
+            const std::string_view expected = pattern_view(m_expected);
+            return actual.size() >= expected.size()
+                   && segment_equal(actual.substr(actual.size() - expected.size()), expected, m_comparison);
+        }
+
+        bool operator()(const segmented_string_view& actual) const
+        {
+            const std::string_view expected = pattern_view(m_expected);
+            return actual.size() >= expected.size()
+                   && segments_equal(actual, actual.size() - expected.size(), expected, m_comparison);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const basic_impl& item)
+        {
+            return os << "(string_ends_with " << item.m_comparison << " \"" << item.m_expected << "\")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const basic_impl& item)
+        {
+            return write_string_test(out, "string_ends_with", item.m_expected, item.m_comparison);
+        }
+    };
+
+    using impl = basic_impl<std::string>;
+};
+
+struct no_searcher
+{
+    no_searcher(std::string_view, string_comparison)
+    {
+    }
+};
+
+template <class Pattern>
+using searcher_t = std::conditional_t<std::is_same_v<Pattern, std::string>, kmp_searcher, no_searcher>;
+
+struct string_contains_fn : string_test_fn<string_contains_fn>
+{
+    template <class Pattern>
+    struct basic_impl
+    {
+        using string_test_type = string_contains_fn;
+        static constexpr std::size_t cost = scan_cost;
+
+        Pattern m_expected;
+        string_comparison m_comparison;
+        searcher_t<Pattern> m_searcher;
+
+        static basic_impl create(Pattern expected, string_comparison comparison)
+        {
+            searcher_t<Pattern> searcher{ pattern_view(expected), comparison };
+            return basic_impl{ std::move(expected), comparison, std::move(searcher) };
+        }
+
+        bool operator()(std::string_view actual) const
+        {
+            const std::string_view expected = pattern_view(m_expected);
+            if (m_comparison == string_comparison::case_sensitive)
+            {
+                return actual.find(expected) != std::string_view::npos;
+            }
+            return std::search(actual.begin(), actual.end(), expected.begin(), expected.end(), char_equal{ m_comparison })
+                   != actual.end();
+        }
+
+        bool operator()(const segmented_string_view& actual) const
+        {
+            if constexpr (std::is_same_v<searcher_t<Pattern>, kmp_searcher>)
+            {
+                return m_searcher.search(actual, pattern_view(m_expected), m_comparison);
+            }
+            else
+            {
+                const std::string_view expected = pattern_view(m_expected);
+                return std::search(
+                           actual.begin(), actual.end(), expected.begin(), expected.end(), char_equal{ m_comparison })
+                       != actual.end();
+            }
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const basic_impl& item)
+        {
+            return os << "(string_contains " << item.m_comparison << " \"" << item.m_expected << "\")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const basic_impl& item)
+        {
+            return write_string_test(out, "string_contains", item.m_expected, item.m_comparison);
+        }
+    };
+
+    using impl = basic_impl<std::string>;
+};
+
+struct is_digit_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        bool operator()(char item) const
+        {
+            return std::isdigit(static_cast<unsigned char>(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_digit)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+struct is_space_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        bool operator()(char item) const
+        {
+            return std::isspace(static_cast<unsigned char>(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_space)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+struct is_alnum_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        bool operator()(char item) const
+        {
+            return std::isalnum(static_cast<unsigned char>(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_alnum)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+struct is_alpha_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        bool operator()(char item) const
+        {
+            return std::isalpha(static_cast<unsigned char>(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_alpha)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+struct is_upper_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        bool operator()(char item) const
+        {
+            return std::isupper(static_cast<unsigned char>(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_upper)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+struct is_lower_fn
+{
+    struct impl
+    {
+        static constexpr std::size_t cost = 1;
+
+        bool operator()(char item) const
+        {
+            return std::islower(static_cast<unsigned char>(item));
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(is_lower)";
+        }
+    };
+
+    auto operator()() const -> impl
+    {
+        return impl{};
+    }
+};
+
+}  // namespace detail
+
+inline constexpr auto string_is = detail::string_is_fn{};
+inline constexpr auto string_starts_with = detail::string_starts_with_fn{};
+inline constexpr auto string_ends_with = detail::string_ends_with_fn{};
+inline constexpr auto string_contains = detail::string_contains_fn{};
+
+inline constexpr auto is_space = detail::is_space_fn{};
+inline constexpr auto is_digit = detail::is_digit_fn{};
+inline constexpr auto is_alnum = detail::is_alnum_fn{};
+inline constexpr auto is_alpha = detail::is_alpha_fn{};
+inline constexpr auto is_upper = detail::is_upper_fn{};
+inline constexpr auto is_lower = detail::is_lower_fn{};
+
+}  // namespace predicates
+}  // namespace ferrugo
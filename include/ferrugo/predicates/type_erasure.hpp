@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstddef>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/core/types.hpp>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+template <class T>
+struct predicate : std::function<bool(::ferrugo::core::in_t<T>)>
+{
+    using base_t = std::function<bool(::ferrugo::core::in_t<T>)>;
+    using base_t::base_t;
+
+    friend std::ostream& operator<<(std::ostream& os, const predicate& item)
+    {
+        return os << "predicate<" << ::ferrugo::core::type_name<T>() << ">";
+    }
+};
+
+namespace pmr
+{
+
+template <class T>
+class predicate
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    predicate() noexcept = default;
+
+    explicit predicate(const allocator_type& alloc) noexcept : m_alloc{ alloc }
+    {
+    }
+
+    template <
+        class Pred,
+        class = std::enable_if_t<
+            !std::is_same_v<std::decay_t<Pred>, predicate>
+            && std::is_invocable_r_v<bool, const std::decay_t<Pred>&, ::ferrugo::core::in_t<T>>>>
+    predicate(Pred&& pred, const allocator_type& alloc = {}) : m_alloc{ alloc }
+    {
+        using pred_t = std::decay_t<Pred>;
+        m_object = create<pred_t>(m_alloc.resource(), std::forward<Pred>(pred));
+        m_vtable = &vtable_for<pred_t>;
+    }
+
+    predicate(const predicate& other) : predicate(other, allocator_type{})
+    {
+    }
+
+    predicate(const predicate& other, const allocator_type& alloc) : m_alloc{ alloc }
+    {
+        assign_copy(other);
+    }
+
+    predicate(predicate&& other) noexcept
+        : m_vtable{ std::exchange(other.m_vtable, nullptr) }
+        , m_object{ std::exchange(other.m_object, nullptr) }
+        , m_alloc{ other.m_alloc }
+    {
+    }
+
+    predicate(predicate&& other, const allocator_type& alloc) : m_alloc{ alloc }
+    {
+        assign_move(std::move(other));
+    }
+
+    predicate& operator=(const predicate& other)
+    {
+        if (this != &other)
+        {
+            reset();
+            assign_copy(other);
+        }
+        return *this;
+    }
+
+    predicate& operator=(predicate&& other)
+    {
+        if (this != &other)
+        {
+            reset();
+            assign_move(std::move(other));
+        }
+        return *this;
+    }
+
+    ~predicate()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_object != nullptr;
+    }
+
+    bool operator()(::ferrugo::core::in_t<T> item) const
+    {
+        if (!m_object)
+        {
+            throw std::bad_function_call{};
+        }
+        return m_vtable->invoke(m_object, item);
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return m_alloc;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const predicate& item)
+    {
+        if (!item.m_object)
+        {
+            return os << "predicate<" << ::ferrugo::core::type_name<T>() << ">";
+        }
+        item.m_vtable->print(os, item.m_object);
+        return os;
+    }
+
+private:
+    struct vtable
+    {
+        bool (*invoke)(const void*, ::ferrugo::core::in_t<T>);
+        void* (*clone)(const void*, std::pmr::memory_resource*);
+        void (*destroy)(void*, std::pmr::memory_resource*);
+        void (*print)(std::ostream&, const void*);
+    };
+
+    template <class Pred, class... Args>
+    static void* create(std::pmr::memory_resource* resource, Args&&... args)
+    {
+        void* memory = resource->allocate(sizeof(Pred), alignof(Pred));
+        try
+        {
+            return ::new (memory) Pred(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            resource->deallocate(memory, sizeof(Pred), alignof(Pred));
+            throw;
+        }
+    }
+
+    template <class Pred>
+    static inline constexpr vtable vtable_for = {
+        [](const void* object, ::ferrugo::core::in_t<T> item) -> bool { return (*static_cast<const Pred*>(object))(item); },
+        [](const void* object, std::pmr::memory_resource* resource) -> void*
+        { return create<Pred>(resource, *static_cast<const Pred*>(object)); },
+        [](void* object, std::pmr::memory_resource* resource)
+        {
+            if constexpr (!std::is_trivially_destructible_v<Pred>)
+            {
+                static_cast<Pred*>(object)->~Pred();
+            }
+            resource->deallocate(object, sizeof(Pred), alignof(Pred));
+        },
+        [](std::ostream& os, const void* object) { os << ::ferrugo::core::safe_format(*static_cast<const Pred*>(object)); },
+    };
+
+    void assign_copy(const predicate& other)
+    {
+        if (other.m_object)
+        {
+            m_object = other.m_vtable->clone(other.m_object, m_alloc.resource());
+            m_vtable = other.m_vtable;
+        }
+    }
+
+    void assign_move(predicate&& other)
+    {
+        if (m_alloc == other.m_alloc)
+        {
+            m_vtable = std::exchange(other.m_vtable, nullptr);
+            m_object = std::exchange(other.m_object, nullptr);
+        }
+        else
+        {
+            assign_copy(other);
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (m_object)
+        {
+            m_vtable->destroy(m_object, m_alloc.resource());
+            m_object = nullptr;
+            m_vtable = nullptr;
+        }
+    }
+
+    const vtable* m_vtable = nullptr;
+    void* m_object = nullptr;
+    allocator_type m_alloc = {};
+};
+
+}  // namespace pmr
+
+}  // namespace predicates
+}  // namespace ferrugo
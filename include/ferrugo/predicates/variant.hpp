@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <ferrugo/predicates/core.hpp>
+#include <ferrugo/predicates/description.hpp>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace ferrugo
+{
+namespace predicates
+{
+
+namespace detail
+{
+
+template <class T>
+struct variant_with_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        using alternative_type = T;
+        static constexpr std::size_t cost = 1 + predicate_cost<Pred>();
+
+        Pred pred;
+
+        template <class U>
+        bool operator()(U&& item) const
+        {
+            const auto ptr = std::get_if<T>(&item);
+            return ptr && invoke_pred(pred, *ptr);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(variant_with " << core::type_name<T>() << " " << item.pred << ")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const impl& item)
+        {
+            static const std::string name = core::type_name<T>();
+            out = write_text(write_text(write_text(out, "(variant_with "), name), " ");
+            return write_text(format_to_fn{}(out, item.pred), ")");
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred&& pred) const -> impl<std::decay_t<Pred>>
+    {
+        return impl<std::decay_t<Pred>>{ std::forward<Pred>(pred) };
+    }
+};
+
+struct otherwise_fn
+{
+    template <class Pred>
+    struct impl
+    {
+        static constexpr std::size_t cost = predicate_cost<Pred>();
+
+        Pred m_pred;
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            return os << "(otherwise " << item.m_pred << ")";
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const impl& item)
+        {
+            return write_text(format_to_fn{}(write_text(out, "(otherwise "), item.m_pred), ")");
+        }
+    };
+
+    template <class Pred>
+    auto operator()(Pred&& pred) const -> impl<std::decay_t<Pred>>
+    {
+        return impl<std::decay_t<Pred>>{ std::forward<Pred>(pred) };
+    }
+};
+
+template <class T>
+struct is_otherwise : std::false_type
+{
+};
+
+template <class Pred>
+struct is_otherwise<otherwise_fn::impl<Pred>> : std::true_type
+{
+};
+
+template <class Alternative, class Case>
+constexpr bool is_case_for()
+{
+    if constexpr (core::is_detected<alternative_of, Case>{})
+    {
+        return std::is_same_v<alternative_of<Case>, Alternative>;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <std::size_t I, class Variant, class Cases>
+bool match_variant_alternative(const Cases& cases, const Variant& item)
+{
+    using alternative_t = std::variant_alternative_t<I, Variant>;
+    constexpr std::size_t size = flat_size_v<Cases>;
+    constexpr bool has_case = index_fold<false, size>(
+        [](auto i) { return is_case_for<alternative_t, flat_element_t<decltype(i)::value, Cases>>(); });
+    if constexpr (has_case)
+    {
+        const alternative_t& value = *std::get_if<I>(&item);
+        return index_fold<false, size>(
+            [&](auto i)
+            {
+                const auto& c = flat_get<decltype(i)::value>(cases);
+                if constexpr (is_case_for<alternative_t, std::decay_t<decltype(c)>>())
+                {
+                    return invoke_pred(c.pred, value);
+                }
+                else
+                {
+                    return false;
+                }
+            });
+    }
+    else
+    {
+        return index_fold<false, size>(
+            [&](auto i)
+            {
+                const auto& c = flat_get<decltype(i)::value>(cases);
+                if constexpr (is_otherwise<std::decay_t<decltype(c)>>{})
+                {
+                    return invoke_pred(c.m_pred, item);
+                }
+                else
+                {
+                    return false;
+                }
+            });
+    }
+}
+
+template <class Cases, class Variant, std::size_t... I>
+bool match_variant(const Cases& cases, const Variant& item, std::index_sequence<I...>)
+{
+    static constexpr bool (*table[])(const Cases&, const Variant&) = { &match_variant_alternative<I, Variant>... };
+    return !item.valueless_by_exception() && table[item.index()](cases, item);
+}
+
+template <class Cases, class Variant>
+bool match_variant(const Cases& cases, const Variant& item)
+{
+    return match_variant(cases, item, std::make_index_sequence<std::variant_size_v<Variant>>{});
+}
+
+struct variant_match_fn
+{
+    template <class... Cases>
+    struct impl
+    {
+        static constexpr std::size_t cost = 1 + std::max({ std::size_t{ 0 }, predicate_cost<Cases>()... });
+
+        flat_storage_t<Cases...> m_cases;
+
+        template <class... Ts>
+        bool operator()(const std::variant<Ts...>& item) const
+        {
+            return match_variant(m_cases, item);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const impl& item)
+        {
+            os << "(variant_match";
+            flat_for_each(item.m_cases, [&](const auto& c) { os << " " << ::ferrugo::core::safe_format(c); });
+            os << ")";
+            return os;
+        }
+
+        template <class Out>
+        friend Out write_description(Out out, const impl& item)
+        {
+            out = write_text(out, "(variant_match");
+            flat_for_each(item.m_cases, [&](const auto& c) { out = format_to_fn{}(write_text(out, " "), c); });
+            return write_text(out, ")");
+        }
+    };
+
+    template <class... Cases>
+    auto operator()(Cases&&... cases) const -> impl<std::decay_t<Cases>...>
+    {
+        static_assert(
+            ((core::is_detected<alternative_of, std::decay_t<Cases>>{} || is_otherwise<std::decay_t<Cases>>{}) && ...),
+            "variant_match accepts only when<T>(pred) and otherwise(pred) cases");
+        return impl<std::decay_t<Cases>...>{ flat_storage_t<std::decay_t<Cases>...>{ std::forward<Cases>(cases)... } };
+    }
+};
+
+}  // namespace detail
+
+template <class T>
+inline constexpr auto variant_with = detail::variant_with_fn<T>{};
+
+template <class T>
+inline constexpr auto when = detail::variant_with_fn<T>{};
+
+inline constexpr auto otherwise = detail::otherwise_fn{};
+inline constexpr auto variant_match = detail::variant_match_fn{};
+
+}  // namespace predicates
+}  // namespace ferrugo
@@ -0,0 +1,44 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/core/source_location.hpp>
+#include <ferrugo/core/str_t.hpp>
+#include <ferrugo/core/type_traits.hpp>
+#include <ferrugo/core/types.hpp>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+export module ferrugo.predicates;
+
+export
+{
+#include <ferrugo/predicates/predicates.hpp>
+}
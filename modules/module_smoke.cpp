@@ -0,0 +1,16 @@
+#include <string>
+#include <vector>
+
+import ferrugo.predicates;
+
+namespace predicates = ferrugo::predicates;
+
+int main()
+{
+    const auto in_range = predicates::all(predicates::gt(0), predicates::lt(10));
+    const auto words
+        = predicates::each_item(predicates::string_contains("a", predicates::string_comparison::case_sensitive));
+    const predicates::pmr::predicate<int> erased{ in_range };
+    const bool ok = in_range(5) && !in_range(10) && erased(3) && words(std::vector<std::string>{ "abc", "bar" });
+    return ok ? 0 : 1;
+}
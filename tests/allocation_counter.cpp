@@ -0,0 +1,105 @@
+#include "allocation_counter.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+thread_local std::size_t allocations = 0;
+
+void* counted_allocate(std::size_t size, std::size_t alignment)
+{
+    ++allocations;
+    size = std::max<std::size_t>(size, 1);
+#if defined(_MSC_VER)
+    void* ptr = _aligned_malloc(size, std::max(alignment, alignof(std::max_align_t)));
+#else
+    void* ptr = alignment > alignof(std::max_align_t)
+                    ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                    : std::malloc(size);
+#endif
+    if (!ptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+void counted_release(void* ptr) noexcept
+{
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}  // namespace
+
+std::size_t allocation_count() noexcept
+{
+    return allocations;
+}
+
+void* operator new(std::size_t size)
+{
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    counted_release(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    counted_release(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    counted_release(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    counted_release(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    counted_release(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    counted_release(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    counted_release(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    counted_release(ptr);
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ferrugo/predicates/codegen.hpp>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_view_literals;
+
+TEST_CASE("codegen - generate_cpp", "")
+{
+    const auto prog = predicates::compile_program(predicates::all(
+        predicates::element<0>(predicates::any(predicates::lt(0), predicates::ge(100))),
+        predicates::element<1>(predicates::negate(predicates::string_contains("a\"b", predicates::string_comparison::case_sensitive))),
+        predicates::element<2>(predicates::eq(2.0))));
+    predicates::codegen_options options;
+    options.record_type = "std::tuple<int, std::string_view, double>";
+    options.function_name = "match_event";
+
+    const std::string source = predicates::generate_cpp(prog.view(), options);
+    REQUIRE(source.find("using record_type = std::tuple<int, std::string_view, double>;") != std::string::npos);
+    REQUIRE(
+        source.find("const auto rule = predicates::all(\n"
+                    "    predicates::element<0>(\n"
+                    "        predicates::any(\n"
+                    "            predicates::lt(std::int64_t(0)),\n"
+                    "            predicates::ge(std::int64_t(100)))),\n"
+                    "    predicates::element<1>(\n"
+                    "        predicates::negate(\n"
+                    "            predicates::string_contains(\"a\\\"b\"s, predicates::string_comparison::case_sensitive))),\n"
+                    "    predicates::element<2>(\n"
+                    "        predicates::eq(2.0)));\n")
+        != std::string::npos);
+    REQUIRE(source.find("extern \"C\" bool match_event(const void* item) noexcept") != std::string::npos);
+    REQUIRE(source.find("extern \"C\" std::uint32_t match_event_abi_version() noexcept") != std::string::npos);
+    REQUIRE(source.find("extern \"C\" std::size_t match_event_record_size() noexcept") != std::string::npos);
+}
+
+TEST_CASE("codegen - is_in and escaping", "")
+{
+    const auto prog = predicates::program{
+        predicates::program_builder{}.is_in(std::vector<std::string_view>{ "x\n", "\xff" }).finish()
+    };
+    predicates::codegen_options options;
+    options.record_type = "std::string_view";
+    REQUIRE(
+        predicates::generate_cpp(prog.view(), options).find("const auto rule = predicates::any(\"x\\012\"sv, \"\\377\"sv);")
+        != std::string::npos);
+    REQUIRE_THROWS_AS(predicates::generate_cpp(prog.view(), predicates::codegen_options{}), predicates::program_error);
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/predicates/predicates.hpp>
+#include <ferrugo/predicates/prefilter.hpp>
+#include <functional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "matchers.hpp"
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class Pred>
+std::string appended(const Pred& pred)
+{
+    std::string result = "rule: ";
+    predicates::append_description(result, pred);
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("description - matches the stream output", "")
+{
+    const auto pred = predicates::all(
+        predicates::element<0>(predicates::any(1, 2, predicates::ge(100))),
+        predicates::element<1>(predicates::each_item(predicates::negate(predicates::lt(-3)))),
+        predicates::element<1>(predicates::size_is(predicates::le(8))),
+        predicates::element<2>(predicates::ne(std::string{ "none" })),
+        predicates::elements_are(predicates::is_even(), predicates::is_empty(), predicates::eq("x")));
+
+    REQUIRE_THAT(appended(pred), matchers::equal_to("rule: " + core::str(pred)));
+    REQUIRE_THAT(appended(predicates::gt(2.5)), matchers::equal_to("rule: " + core::str(predicates::gt(2.5))));
+    const auto items = predicates::items_are(1, 'c', 3);
+    REQUIRE_THAT(appended(items), matchers::equal_to("rule: " + core::str(items)));
+}
+
+TEST_CASE("description - leaf predicates match the stream output", "")
+{
+    const std::string pattern = "mid";
+    const auto strings = predicates::any(
+        predicates::string_is("abc", predicates::string_comparison::case_sensitive),
+        predicates::string_starts_with("ab", predicates::string_comparison::case_insensitive),
+        predicates::string_ends_with(FERRUGO_STR_T("yz"){}, predicates::string_comparison::case_sensitive),
+        predicates::string_contains(std::cref(pattern), predicates::string_comparison::case_sensitive),
+        predicates::string_matches("[a-z]+"),
+        predicates::string_matches(FERRUGO_STR_T("[0-9]+"){}));
+    REQUIRE_THAT(appended(strings), matchers::equal_to("rule: " + core::str(strings)));
+
+    const auto numbers = predicates::all(
+        predicates::approx_eq(1.5),
+        predicates::approx_eq(2.0, predicates::relative_tolerance(0.25)),
+        predicates::approx_eq(1.0f, predicates::ulp_tolerance(4)),
+        predicates::is_divisible_by(7),
+        predicates::is_in_prefiltered(std::vector<int>{ 1, 2, 3 }));
+    REQUIRE_THAT(appended(numbers), matchers::equal_to("rule: " + core::str(numbers)));
+
+    const auto variants = predicates::variant_match(
+        predicates::when<int>(predicates::gt(0)),
+        predicates::otherwise(predicates::string_is("none", predicates::string_comparison::case_sensitive)));
+    REQUIRE_THAT(appended(variants), matchers::equal_to("rule: " + core::str(variants)));
+    const auto with = predicates::variant_with<int>(predicates::lt(3));
+    REQUIRE_THAT(appended(with), matchers::equal_to("rule: " + core::str(with)));
+
+    const auto items = predicates::all(
+        predicates::starts_with_items(1, 2), predicates::ends_with_items(3), predicates::contains_items(predicates::ge(4)));
+    REQUIRE_THAT(appended(items), matchers::equal_to("rule: " + core::str(items)));
+}
+
+TEST_CASE("description - leaf predicates are rendered without allocating", "")
+{
+    const auto pred = predicates::all(
+        predicates::string_contains("needle", predicates::string_comparison::case_insensitive),
+        predicates::approx_eq(0.5, predicates::absolute_tolerance(0.125)),
+        predicates::is_divisible_by(3));
+    std::string out;
+    out.reserve(256);
+    const std::size_t before = allocation_count();
+    predicates::append_description(out, pred);
+    REQUIRE_THAT(allocation_count() - before, matchers::equal_to(std::size_t{ 0 }));
+    REQUIRE_THAT(out, matchers::equal_to(core::str(pred)));
+}
+
+TEST_CASE("description - format_to writes through an output iterator", "")
+{
+    const auto pred = predicates::any(predicates::lt(-1), predicates::gt(1));
+    std::vector<char> buffer;
+    predicates::format_to(std::back_inserter(buffer), pred);
+    REQUIRE_THAT(std::string(buffer.begin(), buffer.end()), matchers::equal_to(std::string{ "(any (lt -1) (gt 1))" }));
+}
+
+TEST_CASE("description - described caches the rendered text", "")
+{
+    const auto pred = predicates::described(predicates::all(predicates::ge(0), predicates::lt(5)));
+    REQUIRE_THAT(std::string{ pred.description() }, matchers::equal_to(std::string{ "(all (ge 0) (lt 5))" }));
+    REQUIRE_THAT(core::str(pred), matchers::equal_to(std::string{ "(all (ge 0) (lt 5))" }));
+    REQUIRE_THAT(pred(3), matchers::equal_to(true));
+    REQUIRE_THAT(pred(7), matchers::equal_to(false));
+    REQUIRE_THAT(appended(predicates::negate(pred)), matchers::equal_to(std::string{ "rule: (not (all (ge 0) (lt 5)))" }));
+}
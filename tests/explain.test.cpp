@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/predicates/predicates.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+
+TEST_CASE("explain - matching value", "")
+{
+    REQUIRE_THAT(predicates::explain(predicates::gt(3), 5).has_value(), matchers::equal_to(false));
+}
+
+TEST_CASE("explain - failing child of all", "")
+{
+    const auto pred = predicates::all(predicates::ge(0), predicates::lt(10), predicates::ne(7));
+    const auto result = predicates::explain(pred, 12);
+    REQUIRE(result.has_value());
+    REQUIRE_THAT(result->path, matchers::elements_are(std::string{ "all #1" }));
+    REQUIRE_THAT(core::str(*result), matchers::equal_to(std::string{ "at all #1: 12 does not match (lt 10)" }));
+}
+
+TEST_CASE("explain - items and elements", "")
+{
+    using record = std::tuple<int, std::vector<int>>;
+    const auto pred = predicates::all(
+        predicates::element<0>(predicates::gt(0)), predicates::element<1>(predicates::each_item(predicates::lt(5))));
+
+    REQUIRE_THAT(
+        core::str(*predicates::explain(pred, record{ 1, { 1, 2, 9, 3 } })),
+        matchers::equal_to(std::string{ "at all #1 > element 1 > item 2: 9 does not match (lt 5)" }));
+    REQUIRE_THAT(
+        core::str(*predicates::explain(pred, record{ 0, {} })),
+        matchers::equal_to(std::string{ "at all #0 > element 0: 0 does not match (gt 0)" }));
+
+    const auto items = predicates::items_are(1, predicates::gt(4), 3);
+    REQUIRE_THAT(
+        core::str(*predicates::explain(items, std::vector<int>{ 1, 2, 3 })),
+        matchers::equal_to(std::string{ "at item 1: 2 does not match (gt 4)" }));
+    REQUIRE_THAT(predicates::explain(items, std::vector<int>{ 1, 5 })->path.empty(), matchers::equal_to(true));
+
+    const auto size = predicates::size_is(predicates::le(2));
+    REQUIRE_THAT(
+        core::str(*predicates::explain(size, std::vector<int>{ 1, 2, 3 })),
+        matchers::equal_to(std::string{ "at size: 3 does not match (le 2)" }));
+}
+
+TEST_CASE("explain - any is reported as a whole", "")
+{
+    const auto pred = predicates::negate(predicates::any(1, 2));
+    const auto result = predicates::explain(pred, 2);
+    REQUIRE(result.has_value());
+    REQUIRE_THAT(result->path.empty(), matchers::equal_to(true));
+    REQUIRE_THAT(result->predicate, matchers::equal_to(core::str(pred)));
+}
+
+TEST_CASE("explain - assert_that reports the mismatch", "")
+{
+    const auto pred = predicates::each_item(predicates::ge(0));
+    std::string message;
+    try
+    {
+        predicates::assert_that(std::vector<int>{ 3, -1 }, pred);
+    }
+    catch (const predicates::assertion_error& ex)
+    {
+        message = ex.what();
+    }
+    REQUIRE_THAT(message.find("reason: at item 1: -1 does not match (ge 0)") != std::string::npos, matchers::equal_to(true));
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <ferrugo/predicates/line_scanner.hpp>
+#include <ferrugo/predicates/predicates.hpp>
+#include <fstream>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_view_literals;
+
+namespace
+{
+
+auto make_log(std::size_t lines) -> std::string
+{
+    std::string result;
+    for (std::size_t i = 0; i < lines; ++i)
+    {
+        result += (i % 7 == 0) ? "ERROR something failed " : "INFO all good ";
+        result += std::to_string(i);
+        result += '\n';
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("line_scanner - find_lines", "")
+{
+    const auto text = "abc\nxyz\n\nabcd\nab"sv;
+    const auto pred = predicates::string_starts_with("ab", predicates::string_comparison::case_sensitive);
+    const auto offsets = predicates::find_lines(text, pred, predicates::scan_options{ 4, 1 });
+    REQUIRE_THAT(offsets, matchers::elements_are(0u, 9u, 14u));
+    REQUIRE_THAT(predicates::line_at(text, offsets[1]), matchers::equal_to("abcd"sv));
+    REQUIRE_THAT(predicates::line_at(text, offsets[2]), matchers::equal_to("ab"sv));
+    REQUIRE_THAT(predicates::count_lines(text, predicates::is_empty(), predicates::scan_options{ 4, 1 }), matchers::equal_to(1u));
+}
+
+TEST_CASE("line_scanner - chunking preserves order", "")
+{
+    const std::string text = make_log(10000);
+    const auto pred = predicates::string_contains("ERROR", predicates::string_comparison::case_sensitive);
+    const auto expected = predicates::find_lines(text, pred, predicates::scan_options{ 1, 1 });
+    REQUIRE_THAT(expected.size(), matchers::equal_to(1429u));
+    REQUIRE(predicates::find_lines(text, pred, predicates::scan_options{ 8, 64 }) == expected);
+    REQUIRE_THAT(predicates::count_lines(text, pred, predicates::scan_options{ 8, 64 }), matchers::equal_to(1429u));
+}
+
+TEST_CASE("line_scanner - mapped_file", "")
+{
+    const std::string path = "line_scanner.test.txt";
+    {
+        std::ofstream file{ path };
+        file << make_log(100);
+    }
+    {
+        const predicates::mapped_file file{ path };
+        const auto pred = predicates::string_contains("error", predicates::string_comparison::case_insensitive);
+        REQUIRE_THAT(predicates::count_lines(file.contents(), pred), matchers::equal_to(15u));
+    }
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(predicates::mapped_file{ path }, std::system_error);
+}
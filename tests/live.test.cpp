@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <ferrugo/predicates/live.hpp>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_view_literals;
+
+TEST_CASE("live_predicate - publish", "")
+{
+    predicates::live_predicate<int> pred{ predicates::lt(10) };
+    REQUIRE_THAT(pred(5), matchers::equal_to(true));
+    REQUIRE_THAT(pred(15), matchers::equal_to(false));
+    REQUIRE_THAT(pred.version(), matchers::equal_to(0u));
+
+    pred.publish(predicates::ge(10));
+    REQUIRE_THAT(pred(5), matchers::equal_to(false));
+    REQUIRE_THAT(pred(15), matchers::equal_to(true));
+    REQUIRE_THAT(pred.version(), matchers::equal_to(1u));
+}
+
+TEST_CASE("live_rule_set - publish", "")
+{
+    predicates::rule_set<int> first;
+    first.add(1, predicates::eq(1));
+    predicates::live_rule_set<int> rules{ std::move(first) };
+    REQUIRE_THAT(rules.match(1), matchers::elements_are(1u));
+
+    predicates::rule_set<int> second;
+    second.add(2, predicates::ge(1));
+    rules.publish(std::move(second));
+    REQUIRE_THAT(rules.match(1), matchers::elements_are(2u));
+}
+
+TEST_CASE("live_predicate - readers are not blocked by reloads", "")
+{
+    static constexpr std::size_t reader_count = 32;
+    static constexpr int reload_count = 200;
+
+    std::atomic<std::size_t> evaluations{ 0 };
+    std::atomic<std::size_t> slow_teardowns{ 0 };
+    std::atomic<std::size_t> stalled_teardowns{ 0 };
+
+    struct payload
+    {
+        std::vector<int> m_values;
+        std::atomic<std::size_t>* m_evaluations;
+        std::atomic<std::size_t>* m_slow_teardowns;
+        std::atomic<std::size_t>* m_stalled_teardowns;
+
+        payload(
+            std::vector<int> values,
+            std::atomic<std::size_t>* evaluations,
+            std::atomic<std::size_t>* slow_teardowns,
+            std::atomic<std::size_t>* stalled_teardowns)
+            : m_values{ std::move(values) }
+            , m_evaluations{ evaluations }
+            , m_slow_teardowns{ slow_teardowns }
+            , m_stalled_teardowns{ stalled_teardowns }
+        {
+        }
+
+        payload(const payload&) = delete;
+        payload& operator=(const payload&) = delete;
+
+        ~payload()
+        {
+            if (m_slow_teardowns)
+            {
+                const std::size_t before = m_evaluations->load();
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                m_slow_teardowns->fetch_add(1);
+                if (m_evaluations->load() == before)
+                {
+                    m_stalled_teardowns->fetch_add(1);
+                }
+            }
+            std::fill(m_values.begin(), m_values.end(), -1);
+        }
+    };
+
+    struct version_check
+    {
+        std::shared_ptr<const payload> m_payload;
+
+        bool operator()(int) const
+        {
+            const std::vector<int>& values = m_payload->m_values;
+            return values.front() >= 0
+                   && std::all_of(values.begin(), values.end(), [&](int v) { return v == values.front(); });
+        }
+    };
+
+    const auto make_version = [&](int version) -> predicates::predicate<int>
+    {
+        const bool slow = version % 50 == 25;
+        return version_check{ std::make_shared<const payload>(
+            std::vector<int>(256, version), &evaluations, slow ? &slow_teardowns : nullptr, &stalled_teardowns) };
+    };
+
+    predicates::live_predicate<int> pred{ make_version(0) };
+    std::atomic<bool> done{ false };
+    std::atomic<std::size_t> inconsistent{ 0 };
+    std::vector<std::size_t> per_reader(reader_count, 0);
+
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < reader_count; ++i)
+    {
+        readers.emplace_back(
+            [&, i]()
+            {
+                while (!done.load())
+                {
+                    if (!pred(0))
+                    {
+                        inconsistent.fetch_add(1);
+                    }
+                    ++per_reader[i];
+                    evaluations.fetch_add(1);
+                }
+            });
+    }
+
+    for (int version = 1; version <= reload_count; ++version)
+    {
+        pred.publish(make_version(version));
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    done.store(true);
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    REQUIRE_THAT(pred.version(), matchers::equal_to(static_cast<std::size_t>(reload_count)));
+    REQUIRE_THAT(inconsistent.load(), matchers::equal_to(0u));
+    REQUIRE(std::all_of(per_reader.begin(), per_reader.end(), [](std::size_t n) { return n > 0; }));
+    REQUIRE_THAT(slow_teardowns.load(), matchers::greater(0u));
+    REQUIRE_THAT(stalled_teardowns.load(), matchers::equal_to(0u));
+}
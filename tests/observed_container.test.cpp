@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/predicates/observed_container.hpp>
+#include <ferrugo/predicates/predicates.hpp>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_view_literals;
+
+TEST_CASE("observed_container - each_item and contains_item", "")
+{
+    predicates::observed_container<std::vector<int>> items{ std::vector<int>{ 2, 4, 6 } };
+    const auto all_even = items.track(predicates::each_item(predicates::is_even()));
+    const auto has_negative = items.track(predicates::contains_item(predicates::lt(0)));
+    REQUIRE_THAT(core::str(all_even), matchers::equal_to("(each_item (is_even))"sv));
+    REQUIRE_THAT(core::str(has_negative), matchers::equal_to("(contains_item (lt 0))"sv));
+    REQUIRE_THAT(all_even(items), matchers::equal_to(true));
+    REQUIRE_THAT(has_negative(items), matchers::equal_to(false));
+
+    items.push_back(-1);
+    REQUIRE_THAT(all_even(items), matchers::equal_to(false));
+    REQUIRE_THAT(has_negative(items), matchers::equal_to(true));
+
+    items.modify(items.begin() + 3, [](int& v) { v = -2; });
+    REQUIRE_THAT(all_even(items), matchers::equal_to(true));
+    REQUIRE_THAT(has_negative(items), matchers::equal_to(true));
+
+    items.erase(items.begin() + 3);
+    REQUIRE_THAT(has_negative(items), matchers::equal_to(false));
+
+    items.insert(items.begin(), 7);
+    REQUIRE_THAT(all_even(items), matchers::equal_to(false));
+    REQUIRE_THAT(items.container(), matchers::elements_are(7, 2, 4, 6));
+
+    items.clear();
+    REQUIRE_THAT(all_even(items), matchers::equal_to(true));
+    REQUIRE_THAT(has_negative(items), matchers::equal_to(false));
+}
+
+TEST_CASE("observed_container - composes with other predicates", "")
+{
+    predicates::observed_container<std::list<int>> items;
+    const auto invariant = predicates::all(
+        items.track(predicates::each_item(predicates::gt(0))), predicates::size_is(predicates::le(2)));
+    REQUIRE_THAT(invariant(items), matchers::equal_to(true));
+    items.push_back(1);
+    items.push_back(2);
+    REQUIRE_THAT(invariant(items), matchers::equal_to(true));
+    items.push_back(3);
+    REQUIRE_THAT(invariant(items), matchers::equal_to(false));
+    items.pop_back();
+    items.push_back(0);
+    REQUIRE_THAT(invariant(items), matchers::equal_to(false));
+}
+
+TEST_CASE("observed_container - associative containers", "")
+{
+    struct level
+    {
+        int quantity;
+    };
+    predicates::observed_container<std::map<int, level>> book;
+    const auto has_empty_level = book.track(predicates::contains_item(
+        predicates::result_of([](const auto& entry) { return entry.second.quantity; }, predicates::eq(0))));
+    REQUIRE_THAT(book.insert({ 100, level{ 5 } }).second, matchers::equal_to(true));
+    REQUIRE_THAT(book.insert({ 100, level{ 0 } }).second, matchers::equal_to(false));
+    REQUIRE_THAT(has_empty_level(book), matchers::equal_to(false));
+
+    book.modify(book.container().find(100), [](auto& entry) { entry.second.quantity = 0; });
+    REQUIRE_THAT(has_empty_level(book), matchers::equal_to(true));
+
+    book.erase(book.container().find(100));
+    REQUIRE_THAT(has_empty_level(book), matchers::equal_to(false));
+    REQUIRE_THAT(book.empty(), matchers::equal_to(true));
+}
+
+TEST_CASE("observed_container - hint, count and range inserts", "")
+{
+    predicates::observed_container<std::set<int>> unique;
+    const auto all_positive = unique.track(predicates::each_item(predicates::gt(0)));
+    unique.insert(5);
+    unique.insert(unique.begin(), 5);
+    unique.emplace(5);
+    REQUIRE_THAT(unique.size(), matchers::equal_to(1u));
+    REQUIRE_THAT(all_positive(unique), matchers::equal_to(true));
+
+    const std::vector<int> more = { 5, 6, 6, -1 };
+    unique.insert(more.begin(), more.end());
+    REQUIRE_THAT(unique.container(), matchers::elements_are(-1, 5, 6));
+    REQUIRE_THAT(all_positive(unique), matchers::equal_to(false));
+    unique.erase(unique.begin());
+    REQUIRE_THAT(all_positive(unique), matchers::equal_to(true));
+
+    predicates::observed_container<std::vector<int>> items{ std::vector<int>{ 1 } };
+    const auto has_negative = items.track(predicates::contains_item(predicates::lt(0)));
+    const auto all_negative = items.track(predicates::each_item(predicates::lt(0)));
+    items.insert(items.begin(), 3, -1);
+    REQUIRE_THAT(items.container(), matchers::elements_are(-1, -1, -1, 1));
+    items.insert(items.begin() + 1, more.begin() + 2, more.end());
+    REQUIRE_THAT(items.container(), matchers::elements_are(-1, 6, -1, -1, -1, 1));
+    items.erase(items.begin() + 1);
+    items.pop_back();
+    REQUIRE_THAT(all_negative(items), matchers::equal_to(true));
+    for (int i = 0; i < 4; ++i)
+    {
+        items.pop_back();
+    }
+    REQUIRE_THAT(items.empty(), matchers::equal_to(true));
+    REQUIRE_THAT(has_negative(items), matchers::equal_to(false));
+    REQUIRE_THAT(all_negative(items), matchers::equal_to(true));
+}
@@ -0,0 +1,32 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ferrugo/predicates/plugin.hpp>
+#include <string_view>
+#include <tuple>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_view_literals;
+
+using record = std::tuple<int, std::string_view>;
+
+TEST_CASE("plugin - generated predicate", "")
+{
+    predicates::plugin_predicate<record> pred{ FERRUGO_GENERATED_PLUGIN };
+    REQUIRE_THAT(pred(record{ -1, "an ERROR occurred"sv }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(record{ 100, "terrible"sv }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(record{ 50, "an ERROR occurred"sv }), matchers::equal_to(false));
+    REQUIRE_THAT(pred(record{ -1, "all good"sv }), matchers::equal_to(false));
+
+    predicates::plugin_predicate<record> moved = std::move(pred);
+    REQUIRE_THAT(moved(record{ -1, "error"sv }), matchers::equal_to(true));
+}
+
+TEST_CASE("plugin - load errors", "")
+{
+    REQUIRE_THROWS_AS(predicates::plugin_predicate<record>{ "no-such-plugin.so" }, predicates::plugin_error);
+    REQUIRE_THROWS_AS(
+        (predicates::plugin_predicate<record>{ FERRUGO_GENERATED_PLUGIN, "missing_function" }), predicates::plugin_error);
+    REQUIRE_THROWS_AS(predicates::plugin_predicate<std::tuple<int>>{ FERRUGO_GENERATED_PLUGIN }, predicates::plugin_error);
+    REQUIRE_THROWS_AS(predicates::plugin_predicate<record>{ FERRUGO_MISMATCHED_PLUGIN }, predicates::plugin_error);
+}
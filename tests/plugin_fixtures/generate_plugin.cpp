@@ -0,0 +1,24 @@
+#include <ferrugo/predicates/codegen.hpp>
+#include <fstream>
+#include <iostream>
+
+namespace predicates = ferrugo::predicates;
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "usage: " << argv[0] << " OUTPUT" << '\n';
+        return 2;
+    }
+
+    const auto prog = predicates::compile_program(predicates::all(
+        predicates::element<0>(predicates::any(predicates::lt(0), predicates::ge(100))),
+        predicates::element<1>(predicates::string_contains("err", predicates::string_comparison::case_insensitive))));
+    predicates::codegen_options options;
+    options.record_type = "std::tuple<int, std::string_view>";
+
+    std::ofstream out{ argv[1] };
+    predicates::generate_cpp(out, prog.view(), options);
+    return out ? 0 : 1;
+}
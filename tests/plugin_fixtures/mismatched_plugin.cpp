@@ -0,0 +1,17 @@
+#include <cstddef>
+#include <cstdint>
+
+extern "C" bool ferrugo_predicate(const void*) noexcept
+{
+    return true;
+}
+
+extern "C" std::uint32_t ferrugo_predicate_abi_version() noexcept
+{
+    return 0;
+}
+
+extern "C" std::size_t ferrugo_predicate_record_size() noexcept
+{
+    return 0;
+}
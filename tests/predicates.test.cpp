@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <ferrugo/core/ostream_utils.hpp>
 #include <ferrugo/predicates/predicates.hpp>
+#include <list>
 
 #include "matchers.hpp"
 
@@ -12,6 +13,42 @@ constexpr auto divisible_by(int divisor)
     return [=](int v) { return v % divisor == 0; };
 }
 
+template <std::size_t... I>
+auto wide_all(std::index_sequence<I...>)
+{
+    return predicates::all(predicates::ne(static_cast<int>(I))..., predicates::lt(1000));
+}
+
+template <std::size_t... I>
+auto wide_any(std::index_sequence<I...>)
+{
+    return predicates::any(predicates::eq(static_cast<int>(2 * I))...);
+}
+
+struct counted_size
+{
+    int* m_calls;
+
+    int operator()(const std::string& v) const
+    {
+        ++*m_calls;
+        return static_cast<int>(v.size());
+    }
+
+    bool operator==(const counted_size& other) const
+    {
+        return m_calls == other.m_calls;
+    }
+};
+
+template <std::size_t... I>
+auto wide_shared_projection(int* calls, std::index_sequence<I...>)
+{
+    return predicates::all(
+        predicates::result_of(counted_size{ calls }, predicates::ne(1000 + static_cast<int>(I)))...,
+        predicates::result_of(counted_size{ calls }, predicates::lt(1000)));
+}
+
 TEST_CASE("predicates - format", "")
 {
     REQUIRE_THAT(  //
@@ -143,6 +180,51 @@ TEST_CASE("predicates - any", "")
     REQUIRE_THAT(pred(100), matchers::equal_to(true));
 }
 
+TEST_CASE("predicates - wide all and any", "")
+{
+    const auto all_pred = wide_all(std::make_index_sequence<300>{});
+    REQUIRE_THAT(all_pred(-1), matchers::equal_to(true));
+    REQUIRE_THAT(all_pred(0), matchers::equal_to(false));
+    REQUIRE_THAT(all_pred(299), matchers::equal_to(false));
+    REQUIRE_THAT(all_pred(300), matchers::equal_to(true));
+    REQUIRE_THAT(all_pred(1000), matchers::equal_to(false));
+
+    const auto any_pred = wide_any(std::make_index_sequence<300>{});
+    REQUIRE_THAT(any_pred(0), matchers::equal_to(true));
+    REQUIRE_THAT(any_pred(1), matchers::equal_to(false));
+    REQUIRE_THAT(any_pred(598), matchers::equal_to(true));
+    REQUIRE_THAT(any_pred(600), matchers::equal_to(false));
+}
+
+TEST_CASE("predicates - wide all with a shared projection", "")
+{
+    int calls = 0;
+    const auto pred = wide_shared_projection(&calls, std::make_index_sequence<400>{});
+    REQUIRE_THAT(pred(std::string{ "abc" }), matchers::equal_to(true));
+    REQUIRE_THAT(calls, matchers::equal_to(1));
+    REQUIRE_THAT(pred(std::string(1200, 'x')), matchers::equal_to(false));
+    REQUIRE_THAT(calls, matchers::equal_to(2));
+}
+
+TEST_CASE("predicates - all with repeated child type", "")
+{
+    struct test_t
+    {
+        int x;
+        int y;
+    };
+    const auto pred = predicates::all(
+        predicates::field(&test_t::x, predicates::ge(0)),
+        predicates::field(&test_t::y, predicates::ge(0)),
+        predicates::field(&test_t::x, predicates::ge(0)));
+    REQUIRE_THAT(  //
+        core::str(pred),
+        matchers::equal_to("(all (field 1 (ge 0)) (field 1 (ge 0)) (field 1 (ge 0)))"sv));
+    REQUIRE_THAT(pred(test_t{ 1, 2 }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(test_t{ 1, -2 }), matchers::equal_to(false));
+    REQUIRE_THAT(pred(test_t{ -1, 2 }), matchers::equal_to(false));
+}
+
 TEST_CASE("predicates - negate", "")
 {
     const auto pred = predicates::negate(predicates::all(predicates::ge(0), predicates::lt(5)));
@@ -216,6 +298,54 @@ TEST_CASE("predicates - contains_item", "")
     REQUIRE_THAT(pred("__"sv), matchers::equal_to(false));
 }
 
+TEST_CASE("predicates - assume_sorted", "")
+{
+    const std::vector<int> ascending = { 1, 3, 3, 5, 8, 13 };
+    const std::vector<int> descending = { 13, 8, 5, 3, 3, 1 };
+    const auto sorted_up = predicates::assume_sorted(ascending);
+    const auto sorted_down = predicates::assume_sorted(descending, std::greater<>{});
+    REQUIRE_THAT(predicates::size_is(6)(sorted_up), matchers::equal_to(true));
+
+    const auto check = [&](const auto& pred)
+    {
+        const auto contains = predicates::contains_item(pred);
+        const auto each = predicates::each_item(pred);
+        REQUIRE_THAT(contains(sorted_up), matchers::equal_to(contains(ascending)));
+        REQUIRE_THAT(each(sorted_up), matchers::equal_to(each(ascending)));
+        REQUIRE_THAT(contains(sorted_down), matchers::equal_to(contains(descending)));
+        REQUIRE_THAT(each(sorted_down), matchers::equal_to(each(descending)));
+    };
+    for (int v = 0; v <= 14; ++v)
+    {
+        check(predicates::eq(v));
+        check(predicates::lt(v));
+        check(predicates::le(v));
+        check(predicates::gt(v));
+        check(predicates::ge(v));
+        check(predicates::all(predicates::ge(v), predicates::lt(v + 3)));
+        check(predicates::all(predicates::gt(v), predicates::le(v + 1)));
+    }
+    REQUIRE_THAT(
+        predicates::contains_item(predicates::all(predicates::ge(4), predicates::lt(8)))(sorted_up),
+        matchers::equal_to(true));
+    REQUIRE_THAT(
+        predicates::contains_item(predicates::all(predicates::ge(6), predicates::lt(8)))(sorted_up),
+        matchers::equal_to(false));
+    REQUIRE_THAT(predicates::each_item(predicates::ge(1))(sorted_up), matchers::equal_to(true));
+
+    const std::vector<int> values = { 1, 2, 3, 4 };
+    const auto typed_up = predicates::assume_sorted(values, std::less<int>{});
+    const auto typed_down = predicates::assume_sorted(std::vector<int>{ 4, 3, 2, 1 }, std::greater<int>{});
+    REQUIRE_THAT(predicates::contains_item(predicates::eq(2.5))(typed_up), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::contains_item(predicates::eq(2.5))(typed_down), matchers::equal_to(false));
+    REQUIRE_THAT(
+        predicates::contains_item(predicates::eq(2.5))(predicates::assume_sorted(values)), matchers::equal_to(false));
+    REQUIRE_THAT(
+        predicates::contains_item(predicates::all(predicates::gt(1.5), predicates::lt(2.5)))(typed_up),
+        matchers::equal_to(true));
+    REQUIRE_THAT(predicates::contains_item(predicates::eq(3))(typed_up), matchers::equal_to(true));
+}
+
 TEST_CASE("predicates - items_are", "")
 {
     const auto pred = predicates::items_are(0, predicates::ge(3), predicates::le(5), 10);
@@ -288,6 +418,30 @@ TEST_CASE("predicates - ends_with_array", "")
     REQUIRE_THAT(pred(std::vector{ 2, 2, 5 }), matchers::equal_to(false));
 }
 
+TEST_CASE("predicates - items over contiguous scalars", "")
+{
+    const std::vector<std::uint8_t> header = { 0x89, 'P', 'N', 'G' };
+    const std::vector<std::uint8_t> packet = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A };
+    REQUIRE_THAT(predicates::starts_with_array(header)(packet), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::starts_with_array(header)(header), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::starts_with_array(packet)(header), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::ends_with_array(std::vector<std::uint8_t>{ 0x0D, 0x0A })(packet), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::items_are_array(header)(packet), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::starts_with_array(std::vector<std::uint8_t>{})(packet), matchers::equal_to(true));
+
+    const std::array<std::uint32_t, 3> words = { 7, 8, 9 };
+    REQUIRE_THAT(predicates::items_are_array(std::array<std::uint32_t, 3>{ 7, 8, 9 })(words), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::items_are_array(std::array<std::uint32_t, 3>{ 7, 8, 10 })(words), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::items_are(7u, 8u, 9u)(words), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::starts_with_items(7u, 8u)(words), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::ends_with_items(8u, 9u)(words), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::ends_with_items(7u, 9u)(words), matchers::equal_to(false));
+
+    REQUIRE_THAT(predicates::starts_with_items('G', 'E', 'T')("GET /"sv), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::ends_with_items('\r', '\n')("GET /\r\n"sv), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::ends_with_items('\r', '\n')("\n"sv), matchers::equal_to(false));
+}
+
 TEST_CASE("predicates - contains_items", "")
 {
     const auto pred = predicates::contains_items(0, predicates::ge(3), predicates::le(5), 10);
@@ -360,6 +514,66 @@ TEST_CASE("predicates - property", "")
     REQUIRE_THAT(pred(test_t{ 12 }), matchers::equal_to(false));
 }
 
+TEST_CASE("predicates - approx_eq", "")
+{
+    const auto pred = predicates::approx_eq(1.0);
+    REQUIRE_THAT(  //
+        core::str(pred),
+        matchers::equal_to("(approx_eq 1)"sv));
+    REQUIRE_THAT(pred(1.0), matchers::equal_to(true));
+    REQUIRE_THAT(pred(1.0 + std::numeric_limits<double>::epsilon() / 2), matchers::equal_to(true));
+    REQUIRE_THAT(pred(1.001), matchers::equal_to(false));
+}
+
+TEST_CASE("predicates - approx_eq tolerances", "")
+{
+    const auto abs_pred = predicates::approx_eq(1000.0, predicates::absolute_tolerance(0.5));
+    REQUIRE_THAT(  //
+        core::str(abs_pred),
+        matchers::equal_to("(approx_eq 1000 (abs 0.5))"sv));
+    REQUIRE_THAT(abs_pred(1000.4), matchers::equal_to(true));
+    REQUIRE_THAT(abs_pred(1000.6), matchers::equal_to(false));
+
+    const auto rel_pred = predicates::approx_eq(1e9, predicates::relative_tolerance(1e-6));
+    REQUIRE_THAT(rel_pred(1e9 + 100.0), matchers::equal_to(true));
+    REQUIRE_THAT(rel_pred(1e9 + 10000.0), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::approx_eq(0.0, predicates::relative_tolerance(1e-6))(0.0), matchers::equal_to(true));
+
+    const auto ulp_pred = predicates::approx_eq(1.0f, predicates::ulp_tolerance(2));
+    REQUIRE_THAT(ulp_pred(std::nextafter(std::nextafter(1.0f, 2.0f), 2.0f)), matchers::equal_to(true));
+    REQUIRE_THAT(ulp_pred(std::nextafter(1.0f, 0.0f)), matchers::equal_to(true));
+    REQUIRE_THAT(ulp_pred(1.0f + 3 * std::numeric_limits<float>::epsilon()), matchers::equal_to(false));
+    REQUIRE_THAT(ulp_pred(std::numeric_limits<float>::quiet_NaN()), matchers::equal_to(false));
+    REQUIRE_THAT(
+        predicates::approx_eq(0.0, predicates::ulp_tolerance(1))(-std::numeric_limits<double>::denorm_min()),
+        matchers::equal_to(true));
+}
+
+TEST_CASE("predicates - approx_eq over contiguous ranges", "")
+{
+    std::vector<double> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = 1.0 + static_cast<double>(i % 7) * 1e-12;
+    }
+    const auto pred = predicates::approx_eq(1.0, predicates::relative_tolerance(1e-9));
+    REQUIRE_THAT(predicates::each_item(pred)(values), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::contains_item(predicates::approx_eq(2.0))(values), matchers::equal_to(false));
+
+    values[993] = 2.0;
+    REQUIRE_THAT(predicates::each_item(pred)(values), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::contains_item(predicates::approx_eq(2.0))(values), matchers::equal_to(true));
+
+    const std::vector<float> actual = { 1.0f, 2.0f, 3.0f };
+    REQUIRE_THAT(
+        predicates::items_are_array(std::vector{ predicates::approx_eq(1.0f), predicates::approx_eq(2.0f), predicates::approx_eq(3.0f) })(
+            actual),
+        matchers::equal_to(true));
+    REQUIRE_THAT(
+        predicates::items_are_array(std::vector{ predicates::approx_eq(1.0f), predicates::approx_eq(2.5f) })(actual),
+        matchers::equal_to(false));
+}
+
 TEST_CASE("predicates - is_divisible_by", "")
 {
     const auto pred = predicates::is_divisible_by(3);
@@ -372,6 +586,38 @@ TEST_CASE("predicates - is_divisible_by", "")
     REQUIRE_THAT(pred(5), matchers::equal_to(false));
 }
 
+TEST_CASE("predicates - is_divisible_by matches remainder", "")
+{
+    for (const int divisor : { 1, 2, 3, 6, 7, 10, 12, 64, 1000, -5, std::numeric_limits<int>::max() })
+    {
+        const auto pred = predicates::is_divisible_by(divisor);
+        for (long long value = -2000; value <= 2000; ++value)
+        {
+            REQUIRE(pred(value) == (value % divisor == 0));
+            REQUIRE(pred(static_cast<int>(value)) == (value % divisor == 0));
+        }
+        REQUIRE(pred(std::numeric_limits<int>::min()) == (std::numeric_limits<int>::min() % divisor == 0));
+        REQUIRE(pred(std::numeric_limits<std::uint64_t>::max()) == (std::numeric_limits<std::uint64_t>::max() % std::abs(divisor) == 0));
+    }
+    REQUIRE_THAT(predicates::is_divisible_by(0)(0), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::is_divisible_by(0)(5), matchers::equal_to(false));
+}
+
+TEST_CASE("predicates - is_divisible_by over contiguous ranges", "")
+{
+    std::vector<int> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<int>(i) * 6 + 3;
+    }
+    REQUIRE_THAT(predicates::each_item(predicates::is_divisible_by(3))(values), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::contains_item(predicates::is_divisible_by(7))(values), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::contains_item(predicates::is_divisible_by(2))(values), matchers::equal_to(false));
+    values[77] += 1;
+    REQUIRE_THAT(predicates::each_item(predicates::is_divisible_by(3))(values), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::contains_item(predicates::is_divisible_by(2))(values), matchers::equal_to(true));
+}
+
 TEST_CASE("predicates - is_odd", "")
 {
     const auto pred = predicates::is_odd();
@@ -497,6 +743,43 @@ TEST_CASE("predicates - variant_with", "")
     REQUIRE_THAT(pred(std::variant<int, std::string>{ "ABC" }), matchers::equal_to(false));
 }
 
+TEST_CASE("predicates - variant_match", "")
+{
+    using variant_t = std::variant<int, std::string, double, char>;
+    const auto pred = predicates::variant_match(
+        predicates::when<int>(predicates::ge(10)),
+        predicates::when<std::string>(predicates::string_starts_with("A", predicates::string_comparison::case_sensitive)),
+        predicates::when<int>(predicates::eq(-1)),
+        predicates::otherwise(predicates::negate(predicates::variant_with<char>('x'))));
+    REQUIRE_THAT(  //
+        core::str(predicates::variant_match(
+            predicates::when<int>(predicates::ge(10)), predicates::otherwise(predicates::variant_with<char>('x')))),
+        matchers::equal_to("(variant_match (variant_with int (ge 10)) (otherwise (variant_with char x)))"sv));
+
+    REQUIRE_THAT(pred(variant_t{ 20 }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(variant_t{ -1 }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(variant_t{ 5 }), matchers::equal_to(false));
+    REQUIRE_THAT(pred(variant_t{ std::string{ "ABC" } }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(variant_t{ std::string{ "XYZ" } }), matchers::equal_to(false));
+    REQUIRE_THAT(pred(variant_t{ 3.0 }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(variant_t{ 'x' }), matchers::equal_to(false));
+    REQUIRE_THAT(pred(variant_t{ 'y' }), matchers::equal_to(true));
+}
+
+TEST_CASE("predicates - any of variant_with", "")
+{
+    using variant_t = std::variant<int, std::string, double>;
+    const auto pred = predicates::any(
+        predicates::variant_with<int>(predicates::ge(10)), predicates::variant_with<double>(predicates::lt(0.0)));
+    REQUIRE_THAT(  //
+        core::str(pred),
+        matchers::equal_to("(any (variant_with int (ge 10)) (variant_with double (lt 0)))"sv));
+    REQUIRE_THAT(pred(variant_t{ 20 }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(variant_t{ 5 }), matchers::equal_to(false));
+    REQUIRE_THAT(pred(variant_t{ -1.0 }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(variant_t{ std::string{ "ABC" } }), matchers::equal_to(false));
+}
+
 TEST_CASE("predicates - string_is case_sensitive", "")
 {
     const auto pred = predicates::string_is("ABC", predicates::string_comparison::case_sensitive);
@@ -518,6 +801,17 @@ TEST_CASE("predicates - string_is case_insensitive", "")
     REQUIRE_THAT(pred("ABCD"), matchers::equal_to(false));
 }
 
+TEST_CASE("predicates - case_insensitive strings with non-ASCII bytes", "")
+{
+    const auto insensitive = predicates::string_comparison::case_insensitive;
+    REQUIRE_THAT(predicates::string_is("Z\xC3\xBCrich", insensitive)("z\xC3\xBCRICH"), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_is("Z\xC3\xBCrich", insensitive)("zurich"), matchers::equal_to(false));
+    REQUIRE_THAT(
+        predicates::string_contains("\xC3\xA9T\xC3\xA9", insensitive)("l'\xC3\xA9t\xC3\xA9"), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::is_alpha()('\xE9'), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::is_space()('\xA0'), matchers::equal_to(false));
+}
+
 TEST_CASE("predicates - string_starts_with case_sensitive", "")
 {
     const auto pred = predicates::string_starts_with("ABC", predicates::string_comparison::case_sensitive);
@@ -627,3 +921,278 @@ TEST_CASE("predicates - string_matches", "")
     REQUIRE_THAT(pred("KL"), matchers::equal_to(false));
     REQUIRE_THAT(pred("KLM88"), matchers::equal_to(false));
 }
+
+TEST_CASE("predicates - string_matches with a static pattern", "")
+{
+    const auto pred = predicates::string_matches(FERRUGO_STR_T("[A-Z]{3}\\d"){});
+
+    REQUIRE_THAT(pred("ABC5"), matchers::equal_to(true));
+    REQUIRE_THAT(pred("KLM8"), matchers::equal_to(true));
+    REQUIRE_THAT(pred("_ABC5_"), matchers::equal_to(false));
+    REQUIRE_THAT(pred("KL"), matchers::equal_to(false));
+    REQUIRE_THAT(pred("KLM88"), matchers::equal_to(false));
+    REQUIRE_THAT(core::str(pred), matchers::equal_to(R"((string_matches "[A-Z]{3}\d"))"));
+
+    const auto request
+        = predicates::string_matches(FERRUGO_STR_T("(GET|POST) (/[^ ?]*)(\\?\\w+=\\w*(&\\w+=\\w*)*)? HTTP/1\\.[01]"){});
+    const auto reference = std::regex(R"((GET|POST) (/[^ ?]*)(\?\w+=\w*(&\w+=\w*)*)? HTTP/1\.[01])");
+    for (const std::string line : { "GET / HTTP/1.1",
+                                    "POST /api/items?id=3&name= HTTP/1.0",
+                                    "GET /a?b HTTP/1.1",
+                                    "PUT / HTTP/1.1",
+                                    "GET /x HTTP/1.2",
+                                    "GET  HTTP/1.1" })
+    {
+        REQUIRE_THAT(request(line), matchers::equal_to(std::regex_match(line, reference)));
+    }
+
+    const auto repeated = predicates::string_matches(FERRUGO_STR_T("a{2,3}(b|c)?x*"){});
+    REQUIRE_THAT(repeated(""), matchers::equal_to(false));
+    REQUIRE_THAT(repeated("aa"), matchers::equal_to(true));
+    REQUIRE_THAT(repeated("aaacxx"), matchers::equal_to(true));
+    REQUIRE_THAT(repeated("aaaa"), matchers::equal_to(false));
+    REQUIRE_THAT(repeated("abc"), matchers::equal_to(false));
+
+    const std::string_view parts[] = { "GET /ind", "ex HTTP/", "1.1" };
+    REQUIRE_THAT(request(predicates::segmented_string_view{ parts }), matchers::equal_to(true));
+}
+
+TEST_CASE("predicates - string predicates with static and borrowed patterns", "")
+{
+    const auto sensitive = predicates::string_comparison::case_sensitive;
+    const auto insensitive = predicates::string_comparison::case_insensitive;
+
+    const auto starts = predicates::string_starts_with(FERRUGO_STR_T("GET "){}, sensitive);
+    REQUIRE_THAT(core::str(starts), matchers::equal_to("(string_starts_with case_sensitive \"GET \")"sv));
+    REQUIRE_THAT(starts("GET /"sv), matchers::equal_to(true));
+    REQUIRE_THAT(starts("POST /"sv), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::string_is(FERRUGO_STR_T("abc"){}, insensitive)("ABC"sv), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_ends_with(FERRUGO_STR_T("\r\n"){}, sensitive)("x\r\n"sv), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_contains(FERRUGO_STR_T("ell"){}, sensitive)("hello"sv), matchers::equal_to(true));
+
+    const std::string needle = "World";
+    const auto contains = predicates::string_contains(std::cref(needle), insensitive);
+    REQUIRE_THAT(core::str(contains), matchers::equal_to("(string_contains case_insensitive \"World\")"sv));
+    REQUIRE_THAT(contains("hello world"sv), matchers::equal_to(true));
+    REQUIRE_THAT(contains("hello"sv), matchers::equal_to(false));
+
+    const std::vector<std::string_view> segments = { "hello wo", "rld" };
+    REQUIRE_THAT(contains(predicates::segmented_string_view{ segments }), matchers::equal_to(true));
+}
+
+TEST_CASE("predicates - string predicates over segmented buffers", "")
+{
+    const std::vector<std::string_view> segments = { "GET /ind", "", "ex.ht", "ml HTTP/1.1", "" };
+    const predicates::segmented_string_view body{ segments };
+    REQUIRE_THAT(core::str(body), matchers::equal_to("GET /index.html HTTP/1.1"sv));
+    REQUIRE_THAT(body.size(), matchers::equal_to(24u));
+
+    const auto sensitive = predicates::string_comparison::case_sensitive;
+    const auto insensitive = predicates::string_comparison::case_insensitive;
+    REQUIRE_THAT(predicates::string_is("GET /index.html HTTP/1.1", sensitive)(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_is("GET /index.html HTTP/1.0", sensitive)(body), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::string_is("get /INDEX.html http/1.1", insensitive)(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_starts_with("GET /index", sensitive)(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_starts_with("GET /inx", sensitive)(body), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::string_ends_with("html HTTP/1.1", sensitive)(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_ends_with("HTML http/1.1", insensitive)(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_ends_with("x.html HTTP/1.0", sensitive)(body), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::string_contains("index.html", sensitive)(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_contains("INDEX.HTML", insensitive)(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_contains("index.htm HTTP", sensitive)(body), matchers::equal_to(false));
+    REQUIRE_THAT(predicates::string_contains("", sensitive)(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_matches(R"(GET (/\S+) HTTP/1\.\d)")(body), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::string_matches(R"(POST .*)")(body), matchers::equal_to(false));
+
+    const std::vector<std::string_view> repeated = { "aab", "aaa", "ab" };
+    REQUIRE_THAT(
+        predicates::string_contains("aaaab", sensitive)(predicates::segmented_string_view{ repeated }),
+        matchers::equal_to(true));
+    REQUIRE_THAT(
+        predicates::string_contains("AaAAb", insensitive)(predicates::segmented_string_view{ repeated }),
+        matchers::equal_to(true));
+    REQUIRE_THAT(
+        predicates::string_contains("aAaAa", insensitive)(predicates::segmented_string_view{ repeated }),
+        matchers::equal_to(false));
+    REQUIRE_THAT(
+        predicates::string_is("", sensitive)(predicates::segmented_string_view{}), matchers::equal_to(true));
+}
+
+TEST_CASE("predicates - sibling projections are evaluated once", "")
+{
+    struct decode
+    {
+        int* m_calls;
+
+        int operator()(const std::string& v) const
+        {
+            ++*m_calls;
+            return static_cast<int>(v.size());
+        }
+
+        bool operator==(const decode& other) const
+        {
+            return m_calls == other.m_calls;
+        }
+    };
+
+    int calls = 0;
+    const auto pred = predicates::all(
+        predicates::result_of(decode{ &calls }, predicates::gt(0)),
+        predicates::result_of(decode{ &calls }, predicates::lt(10)),
+        predicates::result_of(decode{ &calls }, predicates::ne(5)));
+    REQUIRE_THAT(pred(std::string{ "abc" }), matchers::equal_to(true));
+    REQUIRE_THAT(calls, matchers::equal_to(1));
+    REQUIRE_THAT(pred(std::string{ "abcde" }), matchers::equal_to(false));
+    REQUIRE_THAT(calls, matchers::equal_to(2));
+
+    int other_calls = 0;
+    const auto mixed = predicates::any(
+        predicates::result_of(decode{ &calls }, predicates::eq(1)),
+        predicates::result_of(decode{ &other_calls }, predicates::eq(2)),
+        predicates::result_of(decode{ &calls }, predicates::eq(3)));
+    REQUIRE_THAT(mixed(std::string{ "abc" }), matchers::equal_to(true));
+    REQUIRE_THAT(calls, matchers::equal_to(3));
+    REQUIRE_THAT(other_calls, matchers::equal_to(1));
+}
+
+TEST_CASE("predicates - sibling fields", "")
+{
+    struct test_t
+    {
+        int x;
+        int y;
+    };
+    const auto pred = predicates::all(
+        predicates::field(&test_t::x, predicates::ge(0)),
+        predicates::field(&test_t::x, predicates::lt(10)),
+        predicates::field(&test_t::y, predicates::eq(3)));
+    REQUIRE_THAT(  //
+        core::str(pred),
+        matchers::equal_to("(all (field 1 (ge 0)) (field 1 (lt 10)) (field 1 (eq 3)))"sv));
+    REQUIRE_THAT(pred(test_t{ 5, 3 }), matchers::equal_to(true));
+    REQUIRE_THAT(pred(test_t{ 5, 4 }), matchers::equal_to(false));
+    REQUIRE_THAT(pred(test_t{ 10, 3 }), matchers::equal_to(false));
+    REQUIRE_THAT(pred(test_t{ 3, 5 }), matchers::equal_to(false));
+}
+
+TEST_CASE("predicates - check_batch", "")
+{
+    const std::list<int> values = { 2, 4, 5, 6, 7, 9, 10 };
+    const auto is_even = predicates::is_even();
+
+    const auto result = predicates::check_batch(values, is_even, predicates::batch_options{ 2 });
+    REQUIRE_THAT(result.ok(), matchers::equal_to(false));
+    REQUIRE_THAT(result.checked(), matchers::equal_to(7u));
+    REQUIRE_THAT(result.failure_count(), matchers::equal_to(3u));
+    REQUIRE_THAT(result.failures(), matchers::elements_are(2u, 4u));
+    REQUIRE_THAT(
+        result.report(),
+        matchers::equal_to(std::string{ "assertion failed for 3 of 7 items:\n"
+                                        "item 2: 5\n"
+                                        "item 4: 7\n"
+                                        "... and 1 more\n"
+                                        "do not match the predicate: (is_even)\n" }));
+
+    REQUIRE_THAT(predicates::check_batch(std::vector<int>{ 2, 4 }, is_even).ok(), matchers::equal_to(true));
+    const auto owned = predicates::check_batch(std::vector<int>{ 2, 3, 4, 5 }, is_even);
+    REQUIRE_THAT(
+        owned.report(),
+        matchers::equal_to(std::string{ "assertion failed for 2 of 4 items:\n"
+                                        "item 1: 3\n"
+                                        "item 3: 5\n"
+                                        "do not match the predicate: (is_even)\n" }));
+    REQUIRE_NOTHROW(predicates::assert_all(std::vector<int>{ 2, 4 }, is_even));
+    REQUIRE_THROWS_AS(predicates::assert_all(values, is_even), predicates::assertion_error);
+}
+
+TEST_CASE("predicates - all_eager and any_eager", "")
+{
+    int calls = 0;
+    const auto counted = [&](auto pred)
+    {
+        return [&calls, pred](int x)
+        {
+            ++calls;
+            return pred(x);
+        };
+    };
+    const auto all
+        = predicates::all_eager(counted(predicates::ge(0)), counted(predicates::lt(10)), counted(predicates::ne(5)));
+    const auto any
+        = predicates::any_eager(counted(predicates::lt(0)), counted(predicates::gt(10)), counted(predicates::eq(5)));
+
+    for (int x = -3; x < 14; ++x)
+    {
+        REQUIRE_THAT(all(x), matchers::equal_to(x >= 0 && x < 10 && x != 5));
+        REQUIRE_THAT(any(x), matchers::equal_to(x < 0 || x > 10 || x == 5));
+    }
+    REQUIRE_THAT(calls, matchers::equal_to(6 * 17));
+
+    const auto same_type = predicates::all_eager(predicates::ne(1), predicates::ne(2), predicates::ne(3));
+    REQUIRE_THAT(same_type(2), matchers::equal_to(false));
+    REQUIRE_THAT(same_type(4), matchers::equal_to(true));
+    REQUIRE_THAT(
+        core::str(predicates::any_eager(predicates::all_eager(1, 2), predicates::lt(0))),
+        matchers::equal_to("(any_eager (all_eager 1 2) (lt 0))"sv));
+    REQUIRE_THAT(predicates::all_eager()(0), matchers::equal_to(true));
+    REQUIRE_THAT(predicates::any_eager()(0), matchers::equal_to(false));
+
+    calls = 0;
+    const auto alternatives = predicates::any_eager(
+        predicates::variant_with<int>(counted(predicates::ge(0))),
+        predicates::variant_with<std::string>(predicates::eq("x")),
+        predicates::variant_with<int>(counted(predicates::lt(10))));
+    REQUIRE_THAT(alternatives(std::variant<int, std::string>{ 5 }), matchers::equal_to(true));
+    REQUIRE_THAT(alternatives(std::variant<int, std::string>{ "x" }), matchers::equal_to(true));
+    REQUIRE_THAT(alternatives(std::variant<int, std::string>{ "y" }), matchers::equal_to(false));
+    REQUIRE_THAT(calls, matchers::equal_to(2));
+}
+
+TEST_CASE("predicates - static cost", "")
+{
+    using compare_t = decltype(predicates::lt(5));
+    using regex_t = decltype(predicates::string_matches(std::string{ "a.*" }));
+    using scan_t = decltype(predicates::each_item(predicates::lt(5)));
+    using rule_t = decltype(predicates::all(predicates::lt(5), predicates::each_item(predicates::lt(5))));
+
+    REQUIRE_THAT(predicates::static_cost_v<compare_t> < predicates::static_cost_v<scan_t>, matchers::equal_to(true));
+    REQUIRE_THAT(predicates::static_cost_v<scan_t> < predicates::static_cost_v<regex_t>, matchers::equal_to(true));
+    REQUIRE_THAT(
+        predicates::static_cost_v<rule_t>,
+        matchers::equal_to(predicates::static_cost_v<compare_t> + predicates::static_cost_v<scan_t>));
+}
+
+TEST_CASE("predicates - all_by_cost and any_by_cost", "")
+{
+    std::vector<std::string> order;
+    const auto traced = [&](std::string name, bool result)
+    {
+        return [&order, name, result](const std::string&)
+        {
+            order.push_back(name);
+            return result;
+        };
+    };
+    const auto pred = predicates::all_by_cost(
+        predicates::string_matches(std::string{ "[a-z]+" }),
+        predicates::string_contains(std::string{ "b" }, predicates::string_comparison::case_sensitive),
+        traced("unknown", true),
+        predicates::ne(std::string{ "abc" }));
+
+    REQUIRE_THAT(pred("xbz"), matchers::equal_to(true));
+    REQUIRE_THAT(pred("abc"), matchers::equal_to(false));
+    REQUIRE_THAT(pred("Abc"), matchers::equal_to(false));
+    REQUIRE_THAT(order.size(), matchers::equal_to(2u));
+
+    const auto declared
+        = predicates::all_by_cost(predicates::each_item(predicates::lt(5)), predicates::size_is(predicates::gt(1)));
+    REQUIRE_THAT(core::str(declared), matchers::equal_to("(all (each_item (lt 5)) (size_is (gt 1)))"sv));
+    REQUIRE_THAT(declared(std::vector<int>{ 1, 2 }), matchers::equal_to(true));
+
+    const auto any
+        = predicates::any_by_cost(predicates::each_item(predicates::eq(3)), predicates::size_is(predicates::eq(0)));
+    REQUIRE_THAT(any(std::vector<int>{}), matchers::equal_to(true));
+    REQUIRE_THAT(any(std::vector<int>{ 3, 3 }), matchers::equal_to(true));
+    REQUIRE_THAT(any(std::vector<int>{ 1 }), matchers::equal_to(false));
+}
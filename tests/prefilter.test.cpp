@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/predicates/prefilter.hpp>
+#include <string>
+#include <vector>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_view_literals;
+
+TEST_CASE("is_in_prefiltered - integer keys", "")
+{
+    std::vector<std::int64_t> keys;
+    for (std::int64_t i = 0; i < 1000; ++i)
+    {
+        keys.push_back(i * 7);
+    }
+    const auto pred = predicates::is_in_prefiltered(keys);
+    REQUIRE_THAT(core::str(pred), matchers::equal_to("(is_in_prefiltered 1000)"sv));
+    for (std::int64_t i = 0; i < 7000; ++i)
+    {
+        REQUIRE_THAT(pred(i), matchers::equal_to(i % 7 == 0));
+    }
+    REQUIRE_THAT(pred(-7), matchers::equal_to(false));
+}
+
+TEST_CASE("is_in_prefiltered - string keys", "")
+{
+    const auto pred = predicates::is_in_prefiltered({ "alpha", "beta", "gamma", "a somewhat longer key", "" });
+    REQUIRE_THAT(core::str(pred), matchers::equal_to("(is_in_prefiltered 5)"sv));
+    REQUIRE_THAT(pred("alpha"sv), matchers::equal_to(true));
+    REQUIRE_THAT(pred(std::string{ "beta" }), matchers::equal_to(true));
+    REQUIRE_THAT(pred("a somewhat longer key"), matchers::equal_to(true));
+    REQUIRE_THAT(pred(""sv), matchers::equal_to(true));
+    REQUIRE_THAT(pred("alph"sv), matchers::equal_to(false));
+    REQUIRE_THAT(pred("a somewhat longer ke"sv), matchers::equal_to(false));
+}
+
+TEST_CASE("is_in_prefiltered - lookups of another integral type", "")
+{
+    const auto small = predicates::is_in_prefiltered({ 1, 2, 3 });
+    REQUIRE_THAT(small(std::int64_t{ 2 }), matchers::equal_to(true));
+    REQUIRE_THAT(small((std::int64_t{ 1 } << 32) + 1), matchers::equal_to(false));
+    REQUIRE_THAT(small(static_cast<unsigned char>(3)), matchers::equal_to(true));
+
+    const auto unsigned_keys = predicates::is_in_prefiltered({ 4294967295u });
+    REQUIRE_THAT(unsigned_keys(4294967295u), matchers::equal_to(true));
+    REQUIRE_THAT(unsigned_keys(-1), matchers::equal_to(false));
+    REQUIRE_THAT(unsigned_keys(std::int64_t{ 4294967295 }), matchers::equal_to(true));
+}
+
+TEST_CASE("is_in_prefiltered - false positive rate and stats", "")
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i < 20000; ++i)
+    {
+        keys.push_back("key-" + std::to_string(i));
+    }
+    predicates::prefilter_options options;
+    options.false_positive_rate = 0.01;
+    options.collect_stats = true;
+    const auto pred = predicates::is_in_prefiltered(keys, options);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        REQUIRE(pred("key-" + std::to_string(i)));
+    }
+    for (int i = 0; i < 100000; ++i)
+    {
+        REQUIRE_FALSE(pred("other-" + std::to_string(i)));
+    }
+    const predicates::prefilter_stats stats = pred.stats();
+    REQUIRE_THAT(stats.probes, matchers::equal_to(120000u));
+    REQUIRE(stats.false_positives < 2000u);
+    REQUIRE(stats.rejected + stats.false_positives == 100000u);
+    REQUIRE(stats.rejection_rate() > 0.8);
+}
@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/predicates/program.hpp>
+#include <limits>
+#include <vector>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_view_literals;
+
+TEST_CASE("program - compile_program", "")
+{
+    const auto prog = predicates::compile_program(
+        predicates::all(
+            predicates::element<0>(predicates::any(predicates::lt(0), predicates::ge(100))),
+            predicates::element<1>(predicates::string_contains("err", predicates::string_comparison::case_insensitive)),
+            predicates::element<2>(predicates::ne(1.5))));
+
+    REQUIRE(prog(std::make_tuple(-1, "an ERROR occurred"sv, 2.0)));
+    REQUIRE(prog(std::make_tuple(100, "terrible"sv, 0.0)));
+    REQUIRE_FALSE(prog(std::make_tuple(50, "an ERROR occurred"sv, 2.0)));
+    REQUIRE_FALSE(prog(std::make_tuple(-1, "all good"sv, 2.0)));
+    REQUIRE_FALSE(prog(std::make_tuple(-1, "error"sv, 1.5)));
+    REQUIRE_THAT(
+        core::str(prog),
+        matchers::equal_to(
+            "(all (element 0 (any (lt 0) (ge 100))) (element 1 (string_contains case_insensitive \"err\")) (element 2 (ne 1.5)))"sv));
+}
+
+TEST_CASE("program - program_builder", "")
+{
+    const auto prog = predicates::program{ predicates::program_builder{}
+                                               .begin_any()
+                                               .is_in(std::vector<std::int64_t>{ 7, 3, 11, 3 })
+                                               .is_in(std::vector<std::string_view>{ "beta", "alpha" })
+                                               .string_test(
+                                                   predicates::opcode::string_ends_with,
+                                                   ".log",
+                                                   predicates::string_comparison::case_sensitive)
+                                               .end()
+                                               .finish() };
+    REQUIRE(prog(3));
+    REQUIRE(prog(11));
+    REQUIRE_FALSE(prog(4));
+    REQUIRE(prog("alpha"sv));
+    REQUIRE(prog("server.log"sv));
+    REQUIRE_FALSE(prog("gamma"sv));
+    REQUIRE_THAT(
+        core::str(prog), matchers::equal_to("(any (is_in 3 7 11) (is_in alpha beta) (string_ends_with case_sensitive \".log\"))"sv));
+    REQUIRE_THAT(prog.view().node_count(), matchers::equal_to(4u));
+}
+
+TEST_CASE("program - invalid programs are rejected", "")
+{
+    const auto bytes = predicates::program_builder{}.compare(predicates::comparison::eq, 5).finish();
+    REQUIRE_THROWS_AS(predicates::program_view(bytes.data(), 10), predicates::program_error);
+
+    auto bad_magic = bytes;
+    bad_magic[0] = std::byte{ 'X' };
+    REQUIRE_THROWS_AS(predicates::program_view(bad_magic.data(), bad_magic.size()), predicates::program_error);
+
+    auto bad_size = bytes;
+    bad_size.resize(bytes.size() - 4);
+    REQUIRE_THROWS_AS(predicates::program_view(bad_size.data(), bad_size.size()), predicates::program_error);
+
+    REQUIRE_THROWS_AS(predicates::program_builder{}.begin_all().finish(), predicates::program_error);
+    REQUIRE_THROWS_AS(predicates::program_builder{}.begin_negate().end(), predicates::program_error);
+}
+
+namespace
+{
+
+std::vector<std::byte> make_program_bytes(
+    const std::vector<predicates::detail::program_node>& nodes, std::uint64_t data_size, std::uint64_t data_offset = 0)
+{
+    predicates::detail::program_header header = {};
+    std::memcpy(header.magic, predicates::detail::program_magic, sizeof(header.magic));
+    header.version = predicates::detail::program_format_version;
+    header.byte_order = predicates::detail::program_byte_order;
+    header.node_count = static_cast<std::uint32_t>(nodes.size());
+    header.nodes_offset = sizeof(header);
+    header.data_offset = data_offset != 0 ? data_offset : sizeof(header) + nodes.size() * sizeof(nodes[0]);
+    header.data_size = data_size;
+
+    std::vector<std::byte> result(sizeof(header) + nodes.size() * sizeof(nodes[0]) + 64);
+    std::memcpy(result.data(), &header, sizeof(header));
+    std::memcpy(result.data() + sizeof(header), nodes.data(), nodes.size() * sizeof(nodes[0]));
+    return result;
+}
+
+predicates::detail::program_node make_node(predicates::opcode op, std::uint32_t a, std::uint32_t b, std::uint32_t size)
+{
+    predicates::detail::program_node n = {};
+    n.op = op;
+    n.kind = predicates::program_value::kind::string;
+    n.a = a;
+    n.b = b;
+    n.size = size;
+    return n;
+}
+
+}  // namespace
+
+TEST_CASE("program - malformed headers are rejected", "")
+{
+    const std::uint64_t wrap = std::numeric_limits<std::uint64_t>::max() - 15;
+    const std::vector<predicates::detail::program_node> leaf = { make_node(predicates::opcode::string_is, 0, 1, 1) };
+
+    const auto valid = make_program_bytes(leaf, 8);
+    REQUIRE_NOTHROW(predicates::program_view(valid.data(), valid.size()));
+
+    auto nodes_wrap = valid;
+    std::memcpy(nodes_wrap.data() + offsetof(predicates::detail::program_header, nodes_offset), &wrap, sizeof(wrap));
+    REQUIRE_THROWS_AS(predicates::program_view(nodes_wrap.data(), nodes_wrap.size()), predicates::program_error);
+
+    const auto data_wrap = make_program_bytes(leaf, 16, wrap);
+    REQUIRE_THROWS_AS(predicates::program_view(data_wrap.data(), data_wrap.size()), predicates::program_error);
+
+    const auto data_size_wrap = make_program_bytes(leaf, wrap);
+    REQUIRE_THROWS_AS(predicates::program_view(data_size_wrap.data(), data_size_wrap.size()), predicates::program_error);
+
+    const std::uint32_t huge = std::numeric_limits<std::uint32_t>::max();
+    const auto constant_wrap = make_program_bytes({ make_node(predicates::opcode::string_contains, huge, 8, 1) }, 8);
+    REQUIRE_THROWS_AS(predicates::program_view(constant_wrap.data(), constant_wrap.size()), predicates::program_error);
+
+    const auto child_overrun = make_program_bytes(
+        { make_node(predicates::opcode::negate, 0, 0, 2), make_node(predicates::opcode::negate, 0, 0, 2) }, 8);
+    REQUIRE_THROWS_AS(predicates::program_view(child_overrun.data(), child_overrun.size()), predicates::program_error);
+}
+
+TEST_CASE("program - nesting depth is limited", "")
+{
+    predicates::program_builder shallow;
+    for (int i = 0; i < 100; ++i)
+    {
+        shallow.begin_negate();
+    }
+    shallow.compare(predicates::comparison::eq, 1);
+    for (int i = 0; i < 100; ++i)
+    {
+        shallow.end();
+    }
+    const auto prog = predicates::program{ shallow.finish() };
+    REQUIRE(prog(1));
+
+    predicates::program_builder deep;
+    for (std::uint32_t i = 0; i + 1 < predicates::detail::program_max_depth; ++i)
+    {
+        deep.begin_negate();
+    }
+    REQUIRE_THROWS_AS(deep.begin_negate(), predicates::program_error);
+
+    const std::uint32_t depth = 100000;
+    std::vector<predicates::detail::program_node> chain;
+    for (std::uint32_t i = 0; i + 1 < depth; ++i)
+    {
+        chain.push_back(make_node(predicates::opcode::negate, 0, 0, depth - i));
+    }
+    chain.push_back(make_node(predicates::opcode::string_is, 0, 1, 1));
+    const auto crafted = make_program_bytes(chain, 8);
+    REQUIRE_THROWS_AS(predicates::program_view(crafted.data(), crafted.size()), predicates::program_error);
+}
+
+TEST_CASE("program - fields past the end of a record do not match", "")
+{
+    const auto field = [](std::uint32_t index, bool negated)
+    {
+        predicates::program_builder builder;
+        if (negated)
+        {
+            builder.begin_negate();
+        }
+        builder.begin_field(index).compare(predicates::comparison::eq, 1).end();
+        if (negated)
+        {
+            builder.end();
+        }
+        return predicates::program{ builder.finish() };
+    };
+    const auto record = std::make_tuple(2, 1);
+    REQUIRE(field(1, false)(record));
+    REQUIRE_FALSE(field(5, false)(record));
+    REQUIRE(field(5, true)(record));
+    REQUIRE_FALSE(field(0, false)(std::tuple<>{}));
+}
+
+TEST_CASE("program - mapped_program", "")
+{
+    const std::string path = "program.test.bin";
+    predicates::compile_program(predicates::element<1>(predicates::string_is("abc", predicates::string_comparison::case_sensitive)))
+        .save(path);
+    {
+        const predicates::mapped_program prog{ path };
+        REQUIRE(prog(std::make_tuple(1, "abc"sv)));
+        REQUIRE_FALSE(prog(std::make_tuple(1, "abcd"sv)));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("program - static and borrowed string patterns", "")
+{
+    const std::string suffix = ".log";
+    const auto prog = predicates::compile_program(predicates::any(
+        predicates::string_starts_with(FERRUGO_STR_T("tmp/"){}, predicates::string_comparison::case_insensitive),
+        predicates::string_ends_with(std::cref(suffix), predicates::string_comparison::case_sensitive)));
+    REQUIRE_THAT(
+        core::str(prog),
+        matchers::equal_to(
+            "(any (string_starts_with case_insensitive \"tmp/\") (string_ends_with case_sensitive \".log\"))"sv));
+    REQUIRE(prog("TMP/a.txt"sv));
+    REQUIRE(prog("var/a.log"sv));
+    REQUIRE_FALSE(prog("var/a.txt"sv));
+}
@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+#include <ferrugo/core/ostream_utils.hpp>
+#include <ferrugo/predicates/predicates.hpp>
+#include <ferrugo/predicates/rule_set.hpp>
+#include <memory_resource>
+
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_view_literals;
+
+namespace
+{
+
+struct event_t
+{
+    int kind;
+    int price;
+    std::string symbol;
+};
+
+}  // namespace
+
+TEST_CASE("rule_set - equality", "")
+{
+    predicates::rule_set<event_t> rules;
+    rules.add(1, predicates::field(&event_t::kind, predicates::eq(1)));
+    rules.add(2, predicates::field(&event_t::kind, predicates::eq(2)));
+    rules.add(3, predicates::field(&event_t::kind, predicates::any(1, 3)));
+    rules.add(4, predicates::field(&event_t::symbol, predicates::eq("ABC")));
+    REQUIRE_THAT(rules.size(), matchers::equal_to(4u));
+    REQUIRE_THAT(rules.indexed_count(), matchers::equal_to(4u));
+
+    REQUIRE_THAT(rules.match(event_t{ 1, 0, "ABC" }), matchers::elements_are(1u, 3u, 4u));
+    REQUIRE_THAT(rules.match(event_t{ 2, 0, "XYZ" }), matchers::elements_are(2u));
+    REQUIRE_THAT(rules.match(event_t{ 3, 0, "XYZ" }), matchers::elements_are(3u));
+    REQUIRE_THAT(rules.match(event_t{ 4, 0, "XYZ" }), matchers::is_empty());
+}
+
+TEST_CASE("rule_set - ranges", "")
+{
+    predicates::rule_set<event_t> rules;
+    rules.add(1, predicates::field(&event_t::price, predicates::ge(10)));
+    rules.add(2, predicates::field(&event_t::price, predicates::lt(10)));
+    rules.add(3, predicates::field(&event_t::price, predicates::all(predicates::gt(5), predicates::le(20))));
+    rules.add(4, predicates::field(&event_t::price, predicates::all(predicates::ge(20), predicates::lt(30))));
+    REQUIRE_THAT(rules.indexed_count(), matchers::equal_to(4u));
+
+    REQUIRE_THAT(rules.match(event_t{ 0, 5, "" }), matchers::elements_are(2u));
+    REQUIRE_THAT(rules.match(event_t{ 0, 6, "" }), matchers::elements_are(2u, 3u));
+    REQUIRE_THAT(rules.match(event_t{ 0, 10, "" }), matchers::elements_are(1u, 3u));
+    REQUIRE_THAT(rules.match(event_t{ 0, 20, "" }), matchers::elements_are(1u, 3u, 4u));
+    REQUIRE_THAT(rules.match(event_t{ 0, 30, "" }), matchers::elements_are(1u));
+}
+
+TEST_CASE("rule_set - residual and fallback", "")
+{
+    predicates::rule_set<event_t> rules;
+    rules.add(
+        1,
+        predicates::all(
+            predicates::field(&event_t::symbol, predicates::string_starts_with("A", predicates::string_comparison::case_sensitive)),
+            predicates::field(&event_t::kind, predicates::eq(1)),
+            predicates::field(&event_t::price, predicates::gt(100))));
+    rules.add(2, predicates::field(&event_t::kind, predicates::ne(1)));
+    rules.add(3, [](const event_t& e) { return e.symbol.size() == 3; });
+    REQUIRE_THAT(rules.indexed_count(), matchers::equal_to(1u));
+
+    REQUIRE_THAT(rules.match(event_t{ 1, 200, "ABC" }), matchers::elements_are(1u, 3u));
+    REQUIRE_THAT(rules.match(event_t{ 1, 200, "XYZ" }), matchers::elements_are(3u));
+    REQUIRE_THAT(rules.match(event_t{ 1, 50, "AB" }), matchers::is_empty());
+    REQUIRE_THAT(rules.match(event_t{ 2, 50, "AB" }), matchers::elements_are(2u));
+}
+
+TEST_CASE("rule_set - empty compounds are not indexed", "")
+{
+    predicates::rule_set<event_t> rules;
+    rules.add(1, predicates::field(&event_t::kind, predicates::all()));
+    rules.add(2, predicates::field(&event_t::kind, predicates::any()));
+    rules.add(3, predicates::field(&event_t::kind, predicates::eq(1)));
+    REQUIRE_THAT(rules.indexed_count(), matchers::equal_to(1u));
+
+    REQUIRE_THAT(rules.match(event_t{ 1, 0, "" }), matchers::elements_are(1u, 3u));
+    REQUIRE_THAT(rules.match(event_t{ 2, 0, "" }), matchers::elements_are(1u));
+}
+
+TEST_CASE("rule_set - constants of different signedness are not indexed", "")
+{
+    predicates::rule_set<event_t> rules;
+    const auto unsigned_bound = predicates::field(&event_t::price, predicates::ge(5u));
+    rules.add(1, unsigned_bound);
+    rules.add(2, predicates::field(&event_t::price, predicates::ge(5)));
+    rules.add(3, predicates::field(&event_t::kind, predicates::eq(std::int64_t{ 1 })));
+    REQUIRE_THAT(rules.indexed_count(), matchers::equal_to(2u));
+
+    const event_t negative{ 1, -3, "" };
+    REQUIRE_THAT(unsigned_bound(negative), matchers::equal_to(true));
+    REQUIRE_THAT(rules.match(negative), matchers::elements_are(1u, 3u));
+    REQUIRE_THAT(rules.match(event_t{ 0, 7, "" }), matchers::elements_are(1u, 2u));
+}
+
+TEST_CASE("rule_set - batch", "")
+{
+    predicates::rule_set<event_t> rules;
+    rules.add(1, predicates::field(&event_t::kind, predicates::eq(1)));
+    rules.add(2, predicates::field(&event_t::price, predicates::ge(10)));
+
+    const std::vector<event_t> events = { { 1, 0, "" }, { 2, 20, "" }, { 1, 10, "" } };
+    const auto result = rules.match_each(events);
+    REQUIRE_THAT(result.size(), matchers::equal_to(3u));
+    REQUIRE_THAT(result[0], matchers::elements_are(1u));
+    REQUIRE_THAT(result[1], matchers::elements_are(2u));
+    REQUIRE_THAT(result[2], matchers::elements_are(1u, 2u));
+}
+
+TEST_CASE("rule_set - memory resource", "")
+{
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::memory_resource* const previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        predicates::rule_set<event_t> rules{ &arena };
+        rules.add(
+            1,
+            predicates::all(
+                predicates::field(&event_t::kind, predicates::eq(1)),
+                predicates::field(&event_t::price, predicates::gt(100))));
+        rules.add(2, predicates::field(&event_t::kind, predicates::any(2, 3)));
+        rules.add(3, predicates::field(&event_t::price, predicates::all(predicates::ge(10), predicates::lt(20))));
+        rules.add(4, [](const event_t& e) { return e.symbol.size() == 3; });
+        REQUIRE_THAT(rules.get_allocator().resource() == &arena, matchers::equal_to(true));
+        REQUIRE_THAT(rules.indexed_count(), matchers::equal_to(3u));
+
+        REQUIRE_THAT(rules.match(event_t{ 1, 200, "ABC" }), matchers::elements_are(1u, 4u));
+        REQUIRE_THAT(rules.match(event_t{ 3, 15, "AB" }), matchers::elements_are(2u, 3u));
+    }
+    std::pmr::set_default_resource(previous);
+}
+
+TEST_CASE("rule_set - pmr predicate", "")
+{
+    std::pmr::monotonic_buffer_resource first;
+    std::pmr::monotonic_buffer_resource second;
+
+    predicates::pmr::predicate<int> pred{ predicates::all(predicates::ge(0), predicates::lt(5)), &first };
+    REQUIRE_THAT(pred(3), matchers::equal_to(true));
+    REQUIRE_THAT(pred(7), matchers::equal_to(false));
+    REQUIRE_THAT(core::str(pred), matchers::equal_to("(all (ge 0) (lt 5))"sv));
+
+    const predicates::pmr::predicate<int> copy{ pred, &second };
+    REQUIRE_THAT(copy.get_allocator().resource() == &second, matchers::equal_to(true));
+    REQUIRE_THAT(copy(4), matchers::equal_to(true));
+
+    predicates::pmr::predicate<int> moved{ std::move(pred) };
+    REQUIRE_THAT(moved.get_allocator().resource() == &first, matchers::equal_to(true));
+    REQUIRE_THAT(static_cast<bool>(pred), matchers::equal_to(false));
+    REQUIRE_THAT(moved(-1), matchers::equal_to(false));
+}
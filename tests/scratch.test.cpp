@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <ferrugo/predicates/predicates.hpp>
+#include <ferrugo/predicates/prefilter.hpp>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "matchers.hpp"
+
+using namespace ferrugo;
+using namespace std::string_literals;
+using namespace std::string_view_literals;
+
+namespace
+{
+
+template <class Func>
+std::size_t allocations_during(Func&& func)
+{
+    const std::size_t before = allocation_count();
+    func();
+    return allocation_count() - before;
+}
+
+template <class Pred, class T>
+std::size_t allocations_per_evaluation(const Pred& pred, const T& value)
+{
+    pred(value);
+    return allocations_during(
+        [&]()
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                static_cast<void>(pred(value));
+            }
+        });
+}
+
+predicates::scratch_string upper_name(const std::tuple<int, std::string>& item)
+{
+    predicates::scratch_string result;
+    for (const char ch : std::get<1>(item))
+    {
+        result.push_back(static_cast<char>(ch >= 'a' && ch <= 'z' ? ch - 'a' + 'A' : ch));
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("scratch_arena - scopes release their allocations", "")
+{
+    predicates::scratch_arena& arena = predicates::scratch_arena::current();
+    const auto start = arena.mark();
+    {
+        const predicates::evaluation_scope scope;
+        void* first = arena.allocate(10, 1);
+        void* second = arena.allocate(sizeof(std::uint64_t), alignof(std::uint64_t));
+        REQUIRE_THAT(reinterpret_cast<std::uintptr_t>(second) % alignof(std::uint64_t), matchers::equal_to(0u));
+        REQUIRE_THAT(first != second, matchers::equal_to(true));
+        arena.allocate(3 * predicates::scratch_arena::initial_block_size, 16);
+    }
+    REQUIRE_THAT(arena.mark().block, matchers::equal_to(start.block));
+    REQUIRE_THAT(arena.mark().offset, matchers::equal_to(start.offset));
+
+    const std::size_t capacity = arena.capacity();
+    const std::size_t allocations = allocations_during(
+        [&]()
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                const predicates::evaluation_scope scope;
+                arena.allocate(3 * predicates::scratch_arena::initial_block_size, 16);
+            }
+        });
+    REQUIRE_THAT(allocations, matchers::equal_to(0u));
+    REQUIRE_THAT(arena.capacity(), matchers::equal_to(capacity));
+}
+
+TEST_CASE("scratch_arena - projections returning scratch strings", "")
+{
+    using record = std::tuple<int, std::string>;
+    const auto pred = predicates::result_of(
+        upper_name, predicates::string_starts_with("JO"s, predicates::string_comparison::case_sensitive));
+    const record item{ 1, "john with a name that does not fit into the small string buffer" };
+
+    REQUIRE_THAT(pred(item), matchers::equal_to(true));
+    REQUIRE_THAT(pred(record{ 2, "mary" }), matchers::equal_to(false));
+    REQUIRE_THAT(allocations_per_evaluation(pred, item), matchers::equal_to(0u));
+}
+
+TEST_CASE("scratch_arena - shared projections returning scratch strings", "")
+{
+    using record = std::tuple<int, std::string>;
+    const auto sensitive = predicates::string_comparison::case_sensitive;
+    const auto run = predicates::all(
+        predicates::result_of(upper_name, predicates::string_starts_with("JO"s, sensitive)),
+        predicates::result_of(upper_name, predicates::string_ends_with("BUFFER"s, sensitive)));
+    const auto homogeneous = predicates::any(
+        predicates::result_of(upper_name, predicates::string_starts_with("MA"s, sensitive)),
+        predicates::result_of(upper_name, predicates::string_starts_with("JO"s, sensitive)));
+    const record item{ 1, "john with a name that does not fit into the small string buffer" };
+
+    REQUIRE_THAT(run(item), matchers::equal_to(true));
+    REQUIRE_THAT(homogeneous(item), matchers::equal_to(true));
+
+    predicates::scratch_arena& arena = predicates::scratch_arena::current();
+    const auto start = arena.mark();
+    const std::size_t capacity = arena.capacity();
+    for (int i = 0; i < 10000; ++i)
+    {
+        static_cast<void>(run(item));
+        static_cast<void>(homogeneous(item));
+    }
+    REQUIRE_THAT(arena.mark().block, matchers::equal_to(start.block));
+    REQUIRE_THAT(arena.mark().offset, matchers::equal_to(start.offset));
+    REQUIRE_THAT(arena.capacity(), matchers::equal_to(capacity));
+}
+
+TEST_CASE("scratch_arena - built-in predicates do not allocate per evaluation", "")
+{
+    const auto insensitive = predicates::string_comparison::case_insensitive;
+    const std::string line = "GET /index.html HTTP/1.1";
+    const std::vector<int> values = { 1, 2, 3, 4, 5 };
+    const std::variant<int, std::string> variant = "text"s;
+
+    REQUIRE_THAT(
+        allocations_per_evaluation(predicates::all(predicates::ge(0), predicates::lt(5)), 3), matchers::equal_to(0u));
+    REQUIRE_THAT(allocations_per_evaluation(predicates::any(1, 2, 3), 4), matchers::equal_to(0u));
+    REQUIRE_THAT(allocations_per_evaluation(predicates::each_item(predicates::lt(9)), values), matchers::equal_to(0u));
+    REQUIRE_THAT(allocations_per_evaluation(predicates::items_are(1, 2, 3, 4, 5), values), matchers::equal_to(0u));
+    REQUIRE_THAT(
+        allocations_per_evaluation(predicates::string_contains("INDEX"s, insensitive), std::string_view{ line }),
+        matchers::equal_to(0u));
+    REQUIRE_THAT(
+        allocations_during([&]() { static_cast<void>(predicates::string_contains("INDEX.HTML HTTP/1.1"s, insensitive)); }),
+        matchers::equal_to(2u));
+    REQUIRE_THAT(
+        allocations_per_evaluation(predicates::string_starts_with("get"s, insensitive), std::string_view{ line }),
+        matchers::equal_to(0u));
+    const auto request = predicates::string_matches(FERRUGO_STR_T("GET /\\S+ HTTP/1\\.\\d"){});
+    REQUIRE_THAT(allocations_per_evaluation(request, std::string_view{ line }), matchers::equal_to(0u));
+    REQUIRE_THAT(
+        allocations_per_evaluation(predicates::is_in_prefiltered({ "GET"s, "POST"s }), "PUT"sv), matchers::equal_to(0u));
+    REQUIRE_THAT(
+        allocations_per_evaluation(predicates::variant_with<std::string>(predicates::eq("text"s)), variant),
+        matchers::equal_to(0u));
+}